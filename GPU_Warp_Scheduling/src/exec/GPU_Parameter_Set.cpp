@@ -18,6 +18,127 @@ int GPU_Parameter_Set::L2Cache_Size = 128;
 int GPU_Parameter_Set::L2Cache_Assoc = 8;
 int GPU_Parameter_Set::L2Cache_Line_Size = 64;
 int GPU_Parameter_Set::L2Cache_Banks = 1;
+int GPU_Parameter_Set::Optimistic_Sim_Threads = 0;
+int GPU_Parameter_Set::Optimistic_Window = 64;
+bool GPU_Parameter_Set::RAM_Thread = false;
+int GPU_Parameter_Set::RAM_Thread_Max_Skew = 64;
+int GPU_Parameter_Set::Max_Warp_Per_Core = 4;
+int GPU_Parameter_Set::Warp_Schedulers_Per_Core = 1;
+bool GPU_Parameter_Set::Exec_Latency_Model = false;
+int GPU_Parameter_Set::Latency_INT = 4;
+int GPU_Parameter_Set::Latency_IMAD = 5;
+int GPU_Parameter_Set::Latency_FP32 = 4;
+int GPU_Parameter_Set::Latency_FP16 = 6;
+int GPU_Parameter_Set::Latency_FP64 = 8;
+int GPU_Parameter_Set::Latency_SFU = 20;
+int GPU_Parameter_Set::Latency_Tensor = 32;
+int GPU_Parameter_Set::Latency_Conv = 14;
+int GPU_Parameter_Set::Latency_Shared_Mem = 24;
+int GPU_Parameter_Set::Latency_Load_Hit = 28;
+int GPU_Parameter_Set::Latency_Misc = 1;
+std::string GPU_Parameter_Set::Opcode_Latency = "";
+bool GPU_Parameter_Set::Non_Blocking_Loads = false;
+bool GPU_Parameter_Set::Enable_Coalescer = false;
+int GPU_Parameter_Set::Coalescer_Sector_Size = 0;
+int GPU_Parameter_Set::Coalescer_Thread_Stride = 0;
+bool GPU_Parameter_Set::Enable_MSHR = false;
+int GPU_Parameter_Set::L1_MSHR_Entries = 32;
+int GPU_Parameter_Set::L1_MSHR_Merge_Slots = 8;
+int GPU_Parameter_Set::L2_MSHR_Entries = 128;
+int GPU_Parameter_Set::L2_MSHR_Merge_Slots = 16;
+bool GPU_Parameter_Set::Enable_Barriers = false;
+bool GPU_Parameter_Set::Shared_Mem_Bank_Model = false;
+int GPU_Parameter_Set::Shared_Mem_Banks = 32;
+int GPU_Parameter_Set::Shared_Mem_Bank_Width = 4;
+int GPU_Parameter_Set::Shared_Mem_Thread_Stride = 0;
+bool GPU_Parameter_Set::Enable_SIMT_Stats = false;
+int GPU_Parameter_Set::SIMT_Stats_Top_PCs = 10;
+bool GPU_Parameter_Set::Enable_Func_Units = false;
+int GPU_Parameter_Set::FU_SP_Units = 4;
+int GPU_Parameter_Set::FU_SP_II = 1;
+int GPU_Parameter_Set::FU_SP_Depth = 0;
+int GPU_Parameter_Set::FU_DP_Units = 2;
+int GPU_Parameter_Set::FU_DP_II = 2;
+int GPU_Parameter_Set::FU_DP_Depth = 0;
+int GPU_Parameter_Set::FU_SFU_Units = 4;
+int GPU_Parameter_Set::FU_SFU_II = 8;
+int GPU_Parameter_Set::FU_SFU_Depth = 0;
+int GPU_Parameter_Set::FU_LDST_Units = 4;
+int GPU_Parameter_Set::FU_LDST_II = 4;
+int GPU_Parameter_Set::FU_LDST_Depth = 0;
+int GPU_Parameter_Set::FU_Tensor_Units = 4;
+int GPU_Parameter_Set::FU_Tensor_II = 2;
+int GPU_Parameter_Set::FU_Tensor_Depth = 0;
+bool GPU_Parameter_Set::Enable_ICache = false;
+int GPU_Parameter_Set::ICache_Size = 16;
+int GPU_Parameter_Set::ICache_Assoc = 4;
+int GPU_Parameter_Set::ICache_Line_Size = 128;
+int GPU_Parameter_Set::Fetch_Width = 4;
+int GPU_Parameter_Set::Inst_Buffer_Size = 4;
+bool GPU_Parameter_Set::Enable_Operand_Collector = false;
+int GPU_Parameter_Set::RF_Banks = 8;
+int GPU_Parameter_Set::RF_Bank_Read_Ports = 1;
+int GPU_Parameter_Set::Collector_Units = 8;
+bool GPU_Parameter_Set::Enable_L2_Atomics = false;
+int GPU_Parameter_Set::Atomic_Op_Cycles = 2;
+int GPU_Parameter_Set::Atomic_Latency = 20;
+int GPU_Parameter_Set::Atomic_Stats_Top_Lines = 10;
+bool GPU_Parameter_Set::Enable_Const_Cache = false;
+int GPU_Parameter_Set::Const_Cache_Size = 16;
+int GPU_Parameter_Set::Const_Cache_Assoc = 4;
+int GPU_Parameter_Set::Const_Cache_Line_Size = 64;
+int GPU_Parameter_Set::Const_Cache_Latency = 4;
+bool GPU_Parameter_Set::Enable_Local_Mem_Space = false;
+Local_Mem_L1_Policy_Types GPU_Parameter_Set::Local_Mem_L1_Policy = Local_Mem_L1_Policy_Types::GLOBAL;
+bool GPU_Parameter_Set::Enable_Cache_Operators = false;
+bool GPU_Parameter_Set::Enable_TLB = false;
+int GPU_Parameter_Set::Page_Size = 4096;
+int GPU_Parameter_Set::L1_TLB_Sets = 16;
+int GPU_Parameter_Set::L1_TLB_Assoc = 4;
+int GPU_Parameter_Set::L2_TLB_Sets = 128;
+int GPU_Parameter_Set::L2_TLB_Assoc = 8;
+int GPU_Parameter_Set::L2_TLB_Latency = 10;
+int GPU_Parameter_Set::Page_Walkers = 8;
+int GPU_Parameter_Set::Page_Walk_Levels = 4;
+int GPU_Parameter_Set::Page_Walk_Cache_Sets = 8;
+int GPU_Parameter_Set::Page_Walk_Cache_Assoc = 4;
+int GPU_Parameter_Set::Page_Walk_Cache_Latency = 2;
+int GPU_Parameter_Set::Page_Walk_Mem_Latency = 200;
+bool GPU_Parameter_Set::Enable_UVM = false;
+int GPU_Parameter_Set::UVM_Fault_Latency = 5000;
+int GPU_Parameter_Set::UVM_Fault_Batch_Size = 256;
+int GPU_Parameter_Set::UVM_Prefetch_Size = 0;
+int GPU_Parameter_Set::UVM_Link_Bandwidth = 16;
+int GPU_Parameter_Set::UVM_Link_Latency = 500;
+bool GPU_Parameter_Set::Enable_Occupancy_Model = false;
+int GPU_Parameter_Set::Core_Max_Threads = 2048;
+int GPU_Parameter_Set::Core_Max_Blocks = 32;
+int GPU_Parameter_Set::Core_Registers = 65536;
+int GPU_Parameter_Set::Core_Shared_Mem = 98304;
+int GPU_Parameter_Set::Reg_Alloc_Unit = 256;
+int GPU_Parameter_Set::Shared_Mem_Alloc_Unit = 256;
+int GPU_Parameter_Set::Default_Regs_Per_Thread = 32;
+int GPU_Parameter_Set::Default_Shared_Mem_Per_Block = 0;
+bool GPU_Parameter_Set::Enable_Clock_Domains = false;
+int GPU_Parameter_Set::Core_Clock_MHz = 1500;
+int GPU_Parameter_Set::L2_Clock_MHz = 1500;
+int GPU_Parameter_Set::DRAM_Clock_MHz = 1500;
+bool GPU_Parameter_Set::Enable_Energy_Model = false;
+double GPU_Parameter_Set::Energy_SP_Inst = 20.0;
+double GPU_Parameter_Set::Energy_DP_Inst = 60.0;
+double GPU_Parameter_Set::Energy_SFU_Inst = 40.0;
+double GPU_Parameter_Set::Energy_LDST_Inst = 30.0;
+double GPU_Parameter_Set::Energy_Tensor_Inst = 250.0;
+double GPU_Parameter_Set::Energy_Other_Inst = 10.0;
+double GPU_Parameter_Set::Energy_L1_Hit = 40.0;
+double GPU_Parameter_Set::Energy_L1_Miss = 60.0;
+double GPU_Parameter_Set::Energy_L2_Hit = 150.0;
+double GPU_Parameter_Set::Energy_L2_Miss = 200.0;
+double GPU_Parameter_Set::Energy_DRAM_Read = 5000.0;
+double GPU_Parameter_Set::Energy_DRAM_Write = 5500.0;
+double GPU_Parameter_Set::Energy_VTA_Lookup = 5.0;
+double GPU_Parameter_Set::Energy_Leakage_Per_Core_Cycle = 40.0;
+std::string GPU_Parameter_Set::Core_Overrides = "";
 
 void GPU_Parameter_Set::XML_serialize(Utils::XmlWriter& xmlwriter)
 {
@@ -113,6 +234,503 @@ void GPU_Parameter_Set::XML_serialize(Utils::XmlWriter& xmlwriter)
   val = std::to_string(L2Cache_Banks);
 	xmlwriter.Write_attribute_string(attr, val);
 
+	attr = "Optimistic_Sim_Threads";
+	val = std::to_string(Optimistic_Sim_Threads);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Optimistic_Window";
+	val = std::to_string(Optimistic_Window);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "RAM_Thread";
+	val = (RAM_Thread ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "RAM_Thread_Max_Skew";
+	val = std::to_string(RAM_Thread_Max_Skew);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Max_Warp_Per_Core";
+	val = std::to_string(Max_Warp_Per_Core);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Warp_Schedulers_Per_Core";
+	val = std::to_string(Warp_Schedulers_Per_Core);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Exec_Latency_Model";
+	val = (Exec_Latency_Model ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_INT";
+	val = std::to_string(Latency_INT);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_IMAD";
+	val = std::to_string(Latency_IMAD);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_FP32";
+	val = std::to_string(Latency_FP32);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_FP16";
+	val = std::to_string(Latency_FP16);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_FP64";
+	val = std::to_string(Latency_FP64);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_SFU";
+	val = std::to_string(Latency_SFU);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_Tensor";
+	val = std::to_string(Latency_Tensor);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_Conv";
+	val = std::to_string(Latency_Conv);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_Shared_Mem";
+	val = std::to_string(Latency_Shared_Mem);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_Load_Hit";
+	val = std::to_string(Latency_Load_Hit);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Latency_Misc";
+	val = std::to_string(Latency_Misc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Opcode_Latency";
+	val = Opcode_Latency;
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Non_Blocking_Loads";
+	val = (Non_Blocking_Loads ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Coalescer";
+	val = (Enable_Coalescer ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Coalescer_Sector_Size";
+	val = std::to_string(Coalescer_Sector_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Coalescer_Thread_Stride";
+	val = std::to_string(Coalescer_Thread_Stride);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_MSHR";
+	val = (Enable_MSHR ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L1_MSHR_Entries";
+	val = std::to_string(L1_MSHR_Entries);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L1_MSHR_Merge_Slots";
+	val = std::to_string(L1_MSHR_Merge_Slots);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_MSHR_Entries";
+	val = std::to_string(L2_MSHR_Entries);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_MSHR_Merge_Slots";
+	val = std::to_string(L2_MSHR_Merge_Slots);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Barriers";
+	val = (Enable_Barriers ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Shared_Mem_Bank_Model";
+	val = (Shared_Mem_Bank_Model ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Shared_Mem_Banks";
+	val = std::to_string(Shared_Mem_Banks);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Shared_Mem_Bank_Width";
+	val = std::to_string(Shared_Mem_Bank_Width);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Shared_Mem_Thread_Stride";
+	val = std::to_string(Shared_Mem_Thread_Stride);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_SIMT_Stats";
+	val = (Enable_SIMT_Stats ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "SIMT_Stats_Top_PCs";
+	val = std::to_string(SIMT_Stats_Top_PCs);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Func_Units";
+	val = (Enable_Func_Units ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SP_Units";
+	val = std::to_string(FU_SP_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SP_II";
+	val = std::to_string(FU_SP_II);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SP_Depth";
+	val = std::to_string(FU_SP_Depth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_DP_Units";
+	val = std::to_string(FU_DP_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_DP_II";
+	val = std::to_string(FU_DP_II);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_DP_Depth";
+	val = std::to_string(FU_DP_Depth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SFU_Units";
+	val = std::to_string(FU_SFU_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SFU_II";
+	val = std::to_string(FU_SFU_II);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_SFU_Depth";
+	val = std::to_string(FU_SFU_Depth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_LDST_Units";
+	val = std::to_string(FU_LDST_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_LDST_II";
+	val = std::to_string(FU_LDST_II);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_LDST_Depth";
+	val = std::to_string(FU_LDST_Depth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_Tensor_Units";
+	val = std::to_string(FU_Tensor_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_Tensor_II";
+	val = std::to_string(FU_Tensor_II);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "FU_Tensor_Depth";
+	val = std::to_string(FU_Tensor_Depth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_ICache";
+	val = (Enable_ICache ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "ICache_Size";
+	val = std::to_string(ICache_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "ICache_Assoc";
+	val = std::to_string(ICache_Assoc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "ICache_Line_Size";
+	val = std::to_string(ICache_Line_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Fetch_Width";
+	val = std::to_string(Fetch_Width);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Inst_Buffer_Size";
+	val = std::to_string(Inst_Buffer_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Operand_Collector";
+	val = (Enable_Operand_Collector ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "RF_Banks";
+	val = std::to_string(RF_Banks);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "RF_Bank_Read_Ports";
+	val = std::to_string(RF_Bank_Read_Ports);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Collector_Units";
+	val = std::to_string(Collector_Units);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_L2_Atomics";
+	val = (Enable_L2_Atomics ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Atomic_Op_Cycles";
+	val = std::to_string(Atomic_Op_Cycles);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Atomic_Latency";
+	val = std::to_string(Atomic_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Atomic_Stats_Top_Lines";
+	val = std::to_string(Atomic_Stats_Top_Lines);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Const_Cache";
+	val = (Enable_Const_Cache ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Const_Cache_Size";
+	val = std::to_string(Const_Cache_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Const_Cache_Assoc";
+	val = std::to_string(Const_Cache_Assoc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Const_Cache_Line_Size";
+	val = std::to_string(Const_Cache_Line_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Const_Cache_Latency";
+	val = std::to_string(Const_Cache_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Local_Mem_Space";
+	val = (Enable_Local_Mem_Space ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Local_Mem_L1_Policy";
+	switch (Local_Mem_L1_Policy) {
+		case Local_Mem_L1_Policy_Types::GLOBAL:
+			val = "GLOBAL";
+			break;
+		case Local_Mem_L1_Policy_Types::BYPASS:
+			val = "BYPASS";
+			break;
+		case Local_Mem_L1_Policy_Types::WRITE_ALLOCATE:
+			val = "WRITE_ALLOCATE";
+			break;
+		default:
+			val = "UNKNOWN";
+			break;
+	}
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Cache_Operators";
+	val = (Enable_Cache_Operators ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_TLB";
+	val = (Enable_TLB ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Size";
+	val = std::to_string(Page_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L1_TLB_Sets";
+	val = std::to_string(L1_TLB_Sets);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L1_TLB_Assoc";
+	val = std::to_string(L1_TLB_Assoc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_TLB_Sets";
+	val = std::to_string(L2_TLB_Sets);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_TLB_Assoc";
+	val = std::to_string(L2_TLB_Assoc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_TLB_Latency";
+	val = std::to_string(L2_TLB_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walkers";
+	val = std::to_string(Page_Walkers);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walk_Levels";
+	val = std::to_string(Page_Walk_Levels);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walk_Cache_Sets";
+	val = std::to_string(Page_Walk_Cache_Sets);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walk_Cache_Assoc";
+	val = std::to_string(Page_Walk_Cache_Assoc);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walk_Cache_Latency";
+	val = std::to_string(Page_Walk_Cache_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Page_Walk_Mem_Latency";
+	val = std::to_string(Page_Walk_Mem_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_UVM";
+	val = (Enable_UVM ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "UVM_Fault_Latency";
+	val = std::to_string(UVM_Fault_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "UVM_Fault_Batch_Size";
+	val = std::to_string(UVM_Fault_Batch_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "UVM_Prefetch_Size";
+	val = std::to_string(UVM_Prefetch_Size);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "UVM_Link_Bandwidth";
+	val = std::to_string(UVM_Link_Bandwidth);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "UVM_Link_Latency";
+	val = std::to_string(UVM_Link_Latency);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Occupancy_Model";
+	val = (Enable_Occupancy_Model ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Max_Threads";
+	val = std::to_string(Core_Max_Threads);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Max_Blocks";
+	val = std::to_string(Core_Max_Blocks);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Registers";
+	val = std::to_string(Core_Registers);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Shared_Mem";
+	val = std::to_string(Core_Shared_Mem);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Reg_Alloc_Unit";
+	val = std::to_string(Reg_Alloc_Unit);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Shared_Mem_Alloc_Unit";
+	val = std::to_string(Shared_Mem_Alloc_Unit);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Default_Regs_Per_Thread";
+	val = std::to_string(Default_Regs_Per_Thread);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Default_Shared_Mem_Per_Block";
+	val = std::to_string(Default_Shared_Mem_Per_Block);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Clock_Domains";
+	val = (Enable_Clock_Domains ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Clock_MHz";
+	val = std::to_string(Core_Clock_MHz);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "L2_Clock_MHz";
+	val = std::to_string(L2_Clock_MHz);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "DRAM_Clock_MHz";
+	val = std::to_string(DRAM_Clock_MHz);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Enable_Energy_Model";
+	val = (Enable_Energy_Model ? "true" : "false");
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_SP_Inst";
+	val = std::to_string(Energy_SP_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_DP_Inst";
+	val = std::to_string(Energy_DP_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_SFU_Inst";
+	val = std::to_string(Energy_SFU_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_LDST_Inst";
+	val = std::to_string(Energy_LDST_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_Tensor_Inst";
+	val = std::to_string(Energy_Tensor_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_Other_Inst";
+	val = std::to_string(Energy_Other_Inst);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_L1_Hit";
+	val = std::to_string(Energy_L1_Hit);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_L1_Miss";
+	val = std::to_string(Energy_L1_Miss);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_L2_Hit";
+	val = std::to_string(Energy_L2_Hit);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_L2_Miss";
+	val = std::to_string(Energy_L2_Miss);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_DRAM_Read";
+	val = std::to_string(Energy_DRAM_Read);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_DRAM_Write";
+	val = std::to_string(Energy_DRAM_Write);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_VTA_Lookup";
+	val = std::to_string(Energy_VTA_Lookup);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Energy_Leakage_Per_Core_Cycle";
+	val = std::to_string(Energy_Leakage_Per_Core_Cycle);
+	xmlwriter.Write_attribute_string(attr, val);
+
+	attr = "Core_Overrides";
+	val = Core_Overrides;
+	xmlwriter.Write_attribute_string(attr, val);
+
 	xmlwriter.Write_close_tag();
 }
 
@@ -188,6 +806,398 @@ void GPU_Parameter_Set::XML_deserialize(rapidxml::xml_node<> *node)
 			} else if (strcmp(param->name(), "L2Cache_Banks") == 0) {
 				std::string val = param->value();
 				L2Cache_Banks = std::stoi(val);
+			} else if (strcmp(param->name(), "Optimistic_Sim_Threads") == 0) {
+				std::string val = param->value();
+				Optimistic_Sim_Threads = std::stoi(val);
+			} else if (strcmp(param->name(), "Optimistic_Window") == 0) {
+				std::string val = param->value();
+				Optimistic_Window = std::stoi(val);
+			} else if (strcmp(param->name(), "RAM_Thread") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				RAM_Thread = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "RAM_Thread_Max_Skew") == 0) {
+				std::string val = param->value();
+				RAM_Thread_Max_Skew = std::stoi(val);
+			} else if (strcmp(param->name(), "Max_Warp_Per_Core") == 0) {
+				std::string val = param->value();
+				Max_Warp_Per_Core = std::stoi(val);
+			} else if (strcmp(param->name(), "Warp_Schedulers_Per_Core") == 0) {
+				std::string val = param->value();
+				Warp_Schedulers_Per_Core = std::stoi(val);
+			} else if (strcmp(param->name(), "Exec_Latency_Model") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Exec_Latency_Model = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Latency_INT") == 0) {
+				std::string val = param->value();
+				Latency_INT = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_IMAD") == 0) {
+				std::string val = param->value();
+				Latency_IMAD = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_FP32") == 0) {
+				std::string val = param->value();
+				Latency_FP32 = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_FP16") == 0) {
+				std::string val = param->value();
+				Latency_FP16 = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_FP64") == 0) {
+				std::string val = param->value();
+				Latency_FP64 = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_SFU") == 0) {
+				std::string val = param->value();
+				Latency_SFU = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_Tensor") == 0) {
+				std::string val = param->value();
+				Latency_Tensor = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_Conv") == 0) {
+				std::string val = param->value();
+				Latency_Conv = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_Shared_Mem") == 0) {
+				std::string val = param->value();
+				Latency_Shared_Mem = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_Load_Hit") == 0) {
+				std::string val = param->value();
+				Latency_Load_Hit = std::stoi(val);
+			} else if (strcmp(param->name(), "Latency_Misc") == 0) {
+				std::string val = param->value();
+				Latency_Misc = std::stoi(val);
+			} else if (strcmp(param->name(), "Opcode_Latency") == 0) {
+				std::string val = param->value();
+				Opcode_Latency = val;
+			} else if (strcmp(param->name(), "Non_Blocking_Loads") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Non_Blocking_Loads = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Enable_Coalescer") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Coalescer = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Coalescer_Sector_Size") == 0) {
+				std::string val = param->value();
+				Coalescer_Sector_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "Coalescer_Thread_Stride") == 0) {
+				std::string val = param->value();
+				Coalescer_Thread_Stride = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_MSHR") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_MSHR = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "L1_MSHR_Entries") == 0) {
+				std::string val = param->value();
+				L1_MSHR_Entries = std::stoi(val);
+			} else if (strcmp(param->name(), "L1_MSHR_Merge_Slots") == 0) {
+				std::string val = param->value();
+				L1_MSHR_Merge_Slots = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_MSHR_Entries") == 0) {
+				std::string val = param->value();
+				L2_MSHR_Entries = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_MSHR_Merge_Slots") == 0) {
+				std::string val = param->value();
+				L2_MSHR_Merge_Slots = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Barriers") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Barriers = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Shared_Mem_Bank_Model") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Shared_Mem_Bank_Model = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Shared_Mem_Banks") == 0) {
+				std::string val = param->value();
+				Shared_Mem_Banks = std::stoi(val);
+			} else if (strcmp(param->name(), "Shared_Mem_Bank_Width") == 0) {
+				std::string val = param->value();
+				Shared_Mem_Bank_Width = std::stoi(val);
+			} else if (strcmp(param->name(), "Shared_Mem_Thread_Stride") == 0) {
+				std::string val = param->value();
+				Shared_Mem_Thread_Stride = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_SIMT_Stats") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_SIMT_Stats = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "SIMT_Stats_Top_PCs") == 0) {
+				std::string val = param->value();
+				SIMT_Stats_Top_PCs = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Func_Units") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Func_Units = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "FU_SP_Units") == 0) {
+				std::string val = param->value();
+				FU_SP_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_SP_II") == 0) {
+				std::string val = param->value();
+				FU_SP_II = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_SP_Depth") == 0) {
+				std::string val = param->value();
+				FU_SP_Depth = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_DP_Units") == 0) {
+				std::string val = param->value();
+				FU_DP_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_DP_II") == 0) {
+				std::string val = param->value();
+				FU_DP_II = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_DP_Depth") == 0) {
+				std::string val = param->value();
+				FU_DP_Depth = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_SFU_Units") == 0) {
+				std::string val = param->value();
+				FU_SFU_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_SFU_II") == 0) {
+				std::string val = param->value();
+				FU_SFU_II = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_SFU_Depth") == 0) {
+				std::string val = param->value();
+				FU_SFU_Depth = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_LDST_Units") == 0) {
+				std::string val = param->value();
+				FU_LDST_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_LDST_II") == 0) {
+				std::string val = param->value();
+				FU_LDST_II = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_LDST_Depth") == 0) {
+				std::string val = param->value();
+				FU_LDST_Depth = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_Tensor_Units") == 0) {
+				std::string val = param->value();
+				FU_Tensor_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_Tensor_II") == 0) {
+				std::string val = param->value();
+				FU_Tensor_II = std::stoi(val);
+			} else if (strcmp(param->name(), "FU_Tensor_Depth") == 0) {
+				std::string val = param->value();
+				FU_Tensor_Depth = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_ICache") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_ICache = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "ICache_Size") == 0) {
+				std::string val = param->value();
+				ICache_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "ICache_Assoc") == 0) {
+				std::string val = param->value();
+				ICache_Assoc = std::stoi(val);
+			} else if (strcmp(param->name(), "ICache_Line_Size") == 0) {
+				std::string val = param->value();
+				ICache_Line_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "Fetch_Width") == 0) {
+				std::string val = param->value();
+				Fetch_Width = std::stoi(val);
+			} else if (strcmp(param->name(), "Inst_Buffer_Size") == 0) {
+				std::string val = param->value();
+				Inst_Buffer_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Operand_Collector") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Operand_Collector = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "RF_Banks") == 0) {
+				std::string val = param->value();
+				RF_Banks = std::stoi(val);
+			} else if (strcmp(param->name(), "RF_Bank_Read_Ports") == 0) {
+				std::string val = param->value();
+				RF_Bank_Read_Ports = std::stoi(val);
+			} else if (strcmp(param->name(), "Collector_Units") == 0) {
+				std::string val = param->value();
+				Collector_Units = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_L2_Atomics") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_L2_Atomics = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Atomic_Op_Cycles") == 0) {
+				std::string val = param->value();
+				Atomic_Op_Cycles = std::stoi(val);
+			} else if (strcmp(param->name(), "Atomic_Latency") == 0) {
+				std::string val = param->value();
+				Atomic_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Atomic_Stats_Top_Lines") == 0) {
+				std::string val = param->value();
+				Atomic_Stats_Top_Lines = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Const_Cache") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Const_Cache = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Const_Cache_Size") == 0) {
+				std::string val = param->value();
+				Const_Cache_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "Const_Cache_Assoc") == 0) {
+				std::string val = param->value();
+				Const_Cache_Assoc = std::stoi(val);
+			} else if (strcmp(param->name(), "Const_Cache_Line_Size") == 0) {
+				std::string val = param->value();
+				Const_Cache_Line_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "Const_Cache_Latency") == 0) {
+				std::string val = param->value();
+				Const_Cache_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Local_Mem_Space") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Local_Mem_Space = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Local_Mem_L1_Policy") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				if (strcmp(val.c_str(), "GLOBAL") == 0) {
+					Local_Mem_L1_Policy = Local_Mem_L1_Policy_Types::GLOBAL;
+				} else if (strcmp(val.c_str(), "BYPASS") == 0) {
+					Local_Mem_L1_Policy = Local_Mem_L1_Policy_Types::BYPASS;
+				} else if (strcmp(val.c_str(), "WRITE_ALLOCATE") == 0) {
+					Local_Mem_L1_Policy = Local_Mem_L1_Policy_Types::WRITE_ALLOCATE;
+				} else {
+					PRINT_ERROR("Unknown local memory L1 policy specified in the GPU configuration file")
+				}
+			} else if (strcmp(param->name(), "Enable_Cache_Operators") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Cache_Operators = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Enable_TLB") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_TLB = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Page_Size") == 0) {
+				std::string val = param->value();
+				Page_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "L1_TLB_Sets") == 0) {
+				std::string val = param->value();
+				L1_TLB_Sets = std::stoi(val);
+			} else if (strcmp(param->name(), "L1_TLB_Assoc") == 0) {
+				std::string val = param->value();
+				L1_TLB_Assoc = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_TLB_Sets") == 0) {
+				std::string val = param->value();
+				L2_TLB_Sets = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_TLB_Assoc") == 0) {
+				std::string val = param->value();
+				L2_TLB_Assoc = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_TLB_Latency") == 0) {
+				std::string val = param->value();
+				L2_TLB_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walkers") == 0) {
+				std::string val = param->value();
+				Page_Walkers = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walk_Levels") == 0) {
+				std::string val = param->value();
+				Page_Walk_Levels = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walk_Cache_Sets") == 0) {
+				std::string val = param->value();
+				Page_Walk_Cache_Sets = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walk_Cache_Assoc") == 0) {
+				std::string val = param->value();
+				Page_Walk_Cache_Assoc = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walk_Cache_Latency") == 0) {
+				std::string val = param->value();
+				Page_Walk_Cache_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Page_Walk_Mem_Latency") == 0) {
+				std::string val = param->value();
+				Page_Walk_Mem_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_UVM") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_UVM = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "UVM_Fault_Latency") == 0) {
+				std::string val = param->value();
+				UVM_Fault_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "UVM_Fault_Batch_Size") == 0) {
+				std::string val = param->value();
+				UVM_Fault_Batch_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "UVM_Prefetch_Size") == 0) {
+				std::string val = param->value();
+				UVM_Prefetch_Size = std::stoi(val);
+			} else if (strcmp(param->name(), "UVM_Link_Bandwidth") == 0) {
+				std::string val = param->value();
+				UVM_Link_Bandwidth = std::stoi(val);
+			} else if (strcmp(param->name(), "UVM_Link_Latency") == 0) {
+				std::string val = param->value();
+				UVM_Link_Latency = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Occupancy_Model") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Occupancy_Model = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Core_Max_Threads") == 0) {
+				std::string val = param->value();
+				Core_Max_Threads = std::stoi(val);
+			} else if (strcmp(param->name(), "Core_Max_Blocks") == 0) {
+				std::string val = param->value();
+				Core_Max_Blocks = std::stoi(val);
+			} else if (strcmp(param->name(), "Core_Registers") == 0) {
+				std::string val = param->value();
+				Core_Registers = std::stoi(val);
+			} else if (strcmp(param->name(), "Core_Shared_Mem") == 0) {
+				std::string val = param->value();
+				Core_Shared_Mem = std::stoi(val);
+			} else if (strcmp(param->name(), "Reg_Alloc_Unit") == 0) {
+				std::string val = param->value();
+				Reg_Alloc_Unit = std::stoi(val);
+			} else if (strcmp(param->name(), "Shared_Mem_Alloc_Unit") == 0) {
+				std::string val = param->value();
+				Shared_Mem_Alloc_Unit = std::stoi(val);
+			} else if (strcmp(param->name(), "Default_Regs_Per_Thread") == 0) {
+				std::string val = param->value();
+				Default_Regs_Per_Thread = std::stoi(val);
+			} else if (strcmp(param->name(), "Default_Shared_Mem_Per_Block") == 0) {
+				std::string val = param->value();
+				Default_Shared_Mem_Per_Block = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Clock_Domains") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Clock_Domains = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Core_Clock_MHz") == 0) {
+				std::string val = param->value();
+				Core_Clock_MHz = std::stoi(val);
+			} else if (strcmp(param->name(), "L2_Clock_MHz") == 0) {
+				std::string val = param->value();
+				L2_Clock_MHz = std::stoi(val);
+			} else if (strcmp(param->name(), "DRAM_Clock_MHz") == 0) {
+				std::string val = param->value();
+				DRAM_Clock_MHz = std::stoi(val);
+			} else if (strcmp(param->name(), "Enable_Energy_Model") == 0) {
+				std::string val = param->value();
+				std::transform(val.begin(), val.end(), val.begin(), ::toupper);
+				Enable_Energy_Model = (val.compare("FALSE") == 0 ? false : true);
+			} else if (strcmp(param->name(), "Energy_SP_Inst") == 0) {
+				std::string val = param->value();
+				Energy_SP_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_DP_Inst") == 0) {
+				std::string val = param->value();
+				Energy_DP_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_SFU_Inst") == 0) {
+				std::string val = param->value();
+				Energy_SFU_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_LDST_Inst") == 0) {
+				std::string val = param->value();
+				Energy_LDST_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_Tensor_Inst") == 0) {
+				std::string val = param->value();
+				Energy_Tensor_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_Other_Inst") == 0) {
+				std::string val = param->value();
+				Energy_Other_Inst = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_L1_Hit") == 0) {
+				std::string val = param->value();
+				Energy_L1_Hit = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_L1_Miss") == 0) {
+				std::string val = param->value();
+				Energy_L1_Miss = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_L2_Hit") == 0) {
+				std::string val = param->value();
+				Energy_L2_Hit = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_L2_Miss") == 0) {
+				std::string val = param->value();
+				Energy_L2_Miss = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_DRAM_Read") == 0) {
+				std::string val = param->value();
+				Energy_DRAM_Read = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_DRAM_Write") == 0) {
+				std::string val = param->value();
+				Energy_DRAM_Write = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_VTA_Lookup") == 0) {
+				std::string val = param->value();
+				Energy_VTA_Lookup = std::stod(val);
+			} else if (strcmp(param->name(), "Energy_Leakage_Per_Core_Cycle") == 0) {
+				std::string val = param->value();
+				Energy_Leakage_Per_Core_Cycle = std::stod(val);
+			} else if (strcmp(param->name(), "Core_Overrides") == 0) {
+				std::string val = param->value();
+				Core_Overrides = val;
 			}
 		}
 	}
@@ -6,6 +6,7 @@
 
 enum class Block_Scheduling_Policy_Types;
 enum class Warp_Scheduling_Policy_Types;
+enum class Local_Mem_L1_Policy_Types;
 
 class GPU_Parameter_Set : public Parameter_Set_Base
 {
@@ -27,6 +28,127 @@ public:
 	static int L2Cache_Assoc;
 	static int L2Cache_Line_Size;
 	static int L2Cache_Banks;
+	static int Optimistic_Sim_Threads;
+	static int Optimistic_Window;
+	static bool RAM_Thread;
+	static int RAM_Thread_Max_Skew;
+	static int Max_Warp_Per_Core;
+	static int Warp_Schedulers_Per_Core;
+	static bool Exec_Latency_Model;
+	static int Latency_INT;
+	static int Latency_IMAD;
+	static int Latency_FP32;
+	static int Latency_FP16;
+	static int Latency_FP64;
+	static int Latency_SFU;
+	static int Latency_Tensor;
+	static int Latency_Conv;
+	static int Latency_Shared_Mem;
+	static int Latency_Load_Hit;
+	static int Latency_Misc;
+	static std::string Opcode_Latency;
+	static bool Non_Blocking_Loads;
+	static bool Enable_Coalescer;
+	static int Coalescer_Sector_Size;
+	static int Coalescer_Thread_Stride;
+	static bool Enable_MSHR;
+	static int L1_MSHR_Entries;
+	static int L1_MSHR_Merge_Slots;
+	static int L2_MSHR_Entries;
+	static int L2_MSHR_Merge_Slots;
+	static bool Enable_Barriers;
+	static bool Shared_Mem_Bank_Model;
+	static int Shared_Mem_Banks;
+	static int Shared_Mem_Bank_Width;
+	static int Shared_Mem_Thread_Stride;
+	static bool Enable_SIMT_Stats;
+	static int SIMT_Stats_Top_PCs;
+	static bool Enable_Func_Units;
+	static int FU_SP_Units;
+	static int FU_SP_II;
+	static int FU_SP_Depth;
+	static int FU_DP_Units;
+	static int FU_DP_II;
+	static int FU_DP_Depth;
+	static int FU_SFU_Units;
+	static int FU_SFU_II;
+	static int FU_SFU_Depth;
+	static int FU_LDST_Units;
+	static int FU_LDST_II;
+	static int FU_LDST_Depth;
+	static int FU_Tensor_Units;
+	static int FU_Tensor_II;
+	static int FU_Tensor_Depth;
+	static bool Enable_ICache;
+	static int ICache_Size;
+	static int ICache_Assoc;
+	static int ICache_Line_Size;
+	static int Fetch_Width;
+	static int Inst_Buffer_Size;
+	static bool Enable_Operand_Collector;
+	static int RF_Banks;
+	static int RF_Bank_Read_Ports;
+	static int Collector_Units;
+	static bool Enable_L2_Atomics;
+	static int Atomic_Op_Cycles;
+	static int Atomic_Latency;
+	static int Atomic_Stats_Top_Lines;
+	static bool Enable_Const_Cache;
+	static int Const_Cache_Size;
+	static int Const_Cache_Assoc;
+	static int Const_Cache_Line_Size;
+	static int Const_Cache_Latency;
+	static bool Enable_Local_Mem_Space;
+	static Local_Mem_L1_Policy_Types Local_Mem_L1_Policy;
+	static bool Enable_Cache_Operators;
+	static bool Enable_TLB;
+	static int Page_Size;
+	static int L1_TLB_Sets;
+	static int L1_TLB_Assoc;
+	static int L2_TLB_Sets;
+	static int L2_TLB_Assoc;
+	static int L2_TLB_Latency;
+	static int Page_Walkers;
+	static int Page_Walk_Levels;
+	static int Page_Walk_Cache_Sets;
+	static int Page_Walk_Cache_Assoc;
+	static int Page_Walk_Cache_Latency;
+	static int Page_Walk_Mem_Latency;
+	static bool Enable_UVM;
+	static int UVM_Fault_Latency;
+	static int UVM_Fault_Batch_Size;
+	static int UVM_Prefetch_Size;
+	static int UVM_Link_Bandwidth;
+	static int UVM_Link_Latency;
+	static bool Enable_Occupancy_Model;
+	static int Core_Max_Threads;
+	static int Core_Max_Blocks;
+	static int Core_Registers;
+	static int Core_Shared_Mem;
+	static int Reg_Alloc_Unit;
+	static int Shared_Mem_Alloc_Unit;
+	static int Default_Regs_Per_Thread;
+	static int Default_Shared_Mem_Per_Block;
+	static bool Enable_Clock_Domains;
+	static int Core_Clock_MHz;
+	static int L2_Clock_MHz;
+	static int DRAM_Clock_MHz;
+	static bool Enable_Energy_Model;
+	static double Energy_SP_Inst;
+	static double Energy_DP_Inst;
+	static double Energy_SFU_Inst;
+	static double Energy_LDST_Inst;
+	static double Energy_Tensor_Inst;
+	static double Energy_Other_Inst;
+	static double Energy_L1_Hit;
+	static double Energy_L1_Miss;
+	static double Energy_L2_Hit;
+	static double Energy_L2_Miss;
+	static double Energy_DRAM_Read;
+	static double Energy_DRAM_Write;
+	static double Energy_VTA_Lookup;
+	static double Energy_Leakage_Per_Core_Cycle;
+	static std::string Core_Overrides;
 
 	void XML_serialize(Utils::XmlWriter& xmlwriter);
 	void XML_deserialize(rapidxml::xml_node<> *node);
@@ -48,7 +48,7 @@ do {                                                              \
   }                                                               \
 } while (0)
 
-#define CYCLE m_simBase->core_pointers_v[0]->get_cycle();
+#define CYCLE (m_clock ? *m_clock : m_simBase->core_pointers_v[0]->get_cycle())
 
 cache_entry_c::cache_entry_c() : m_valid(false), m_last_access_time(0) {
 }
@@ -127,6 +127,11 @@ cache_c::cache_c(string name, int num_set, int assoc, int line_size,
   m_insert_count = 0;
 
   m_enable_partition = enable_partition;
+
+  m_clock = NULL;
+  m_journal_on = false;
+  m_journal_epoch = 0;
+  m_set_journal_epoch.assign(m_num_sets, 0);
 }
 
 cache_c::~cache_c() {
@@ -179,7 +184,10 @@ void *cache_c::access_cache(Addr addr, Addr *line_addr, bool update_repl,
   find_tag_and_set(addr, &tag, &set);
   *line_addr = base_cache_line(addr);
 
-  if (update_repl) update_cache_on_access(*line_addr, set, appl_id);
+  if (update_repl) {
+    journal_set(set);
+    update_cache_on_access(*line_addr, set, appl_id);
+  }
 
   // Walk through the set
   for (int ii = 0; ii < m_assoc; ++ii) {
@@ -282,6 +290,7 @@ void *cache_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line,
   // Get the set where the addr maps and tag to asssociate
   // to the new cache line being returned
   find_tag_and_set(addr, &tag, &set);
+  journal_set(set);
   ins_line = find_replacement_line(set, appl_id);
 
   // Populate the update_line variable if the present line was in use
@@ -334,6 +343,7 @@ bool cache_c::invalidate_cache_line(Addr addr) {
   // Get the set where the addr maps and tag to asssociate
   // to the new cache line being returned
   find_tag_and_set(addr, &tag, &set);
+  journal_set(set);
 
   for (int ii = 0; ii < m_assoc; ++ii) {
     // For each line in based on associativity
@@ -349,6 +359,22 @@ bool cache_c::invalidate_cache_line(Addr addr) {
   return false;
 }
 
+// make a line the least recently used one of its set
+void cache_c::set_evict_first(Addr addr) {
+  Addr tag;
+  int set;
+  find_tag_and_set(addr, &tag, &set);
+  journal_set(set);
+
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    cache_entry_c *line = &(m_set[set]->m_entry[ii]);
+    if (line->m_valid && line->m_tag == tag) {
+      line->m_last_access_time = 0;
+      return;
+    }
+  }
+}
+
 // get a cache line address from an address
 Addr cache_c::base_cache_line(Addr addr) {
   return (addr & ~m_offset_mask);
@@ -357,6 +383,7 @@ Addr cache_c::base_cache_line(Addr addr) {
 // invalidate all cache lines
 void cache_c::invalidate_cache(void) {
   for (int ii = 0; ii < m_num_sets; ++ii) {
+    journal_set(ii);
     for (int jj = 0; jj < m_assoc; ++jj) {
       cache_entry_c *line = &(m_set[ii]->m_entry[jj]);
       line->m_valid = false;
@@ -409,3 +436,57 @@ Counter cache_c::find_min_lru(int set) {
 void cache_c::print_info(int id) {
   cout << "CACHE::L" << id << " cpu: " << m_num_cpu_line << " gpu: " << m_num_gpu_line << "\n";
 }
+
+// start recording modified sets
+void cache_c::begin_journal(void) {
+  ASSERTM(!m_journal_on, "cache journal already active\n");
+  m_journal_on = true;
+  ++m_journal_epoch;
+  m_journal.clear();
+  m_journal_num_cpu_line = m_num_cpu_line;
+  m_journal_num_gpu_line = m_num_gpu_line;
+  m_journal_insert_count = m_insert_count;
+}
+
+// save a set the first time it is modified in the current journal
+void cache_c::journal_set(int set) {
+  if (!m_journal_on || m_set_journal_epoch[set] == m_journal_epoch) return;
+  m_set_journal_epoch[set] = m_journal_epoch;
+
+  journal_rec_s rec;
+  rec.set = set;
+  rec.num_cpu_line = m_set[set]->m_num_cpu_line;
+  rec.num_gpu_line = m_set[set]->m_num_gpu_line;
+  rec.entries.assign(m_set[set]->m_entry, m_set[set]->m_entry + m_assoc);
+  if (m_data_size > 0) {
+    rec.data.resize(m_assoc * m_data_size);
+    for (int ii = 0; ii < m_assoc; ++ii)
+      memcpy(&rec.data[ii * m_data_size], m_set[set]->m_entry[ii].m_data, m_data_size);
+  }
+  m_journal.push_back(rec);
+}
+
+// restore every saved set
+void cache_c::rollback_journal(void) {
+  ASSERTM(m_journal_on, "no active cache journal\n");
+  for (auto rec = m_journal.rbegin(); rec != m_journal.rend(); ++rec) {
+    cache_set_c *set = m_set[rec->set];
+    set->m_num_cpu_line = rec->num_cpu_line;
+    set->m_num_gpu_line = rec->num_gpu_line;
+    for (int ii = 0; ii < m_assoc; ++ii) {
+      set->m_entry[ii] = rec->entries[ii];
+      if (m_data_size > 0)
+        memcpy(set->m_entry[ii].m_data, &rec->data[ii * m_data_size], m_data_size);
+    }
+  }
+  m_num_cpu_line = m_journal_num_cpu_line;
+  m_num_gpu_line = m_journal_num_gpu_line;
+  m_insert_count = m_journal_insert_count;
+  end_journal();
+}
+
+// drop the journal
+void cache_c::end_journal(void) {
+  m_journal_on = false;
+  m_journal.clear();
+}
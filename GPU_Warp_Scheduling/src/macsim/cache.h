@@ -32,6 +32,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #define CACHE_H
 
 #include <string>
+#include <vector>
 
 #include "sim_defs.h"
 #include "macsim.h"
@@ -43,7 +44,10 @@ class core_c;
 
 typedef enum Cache_Type_enum {
   CACHE_DL1,
-  CACHE_DL2
+  CACHE_DL2,
+  CACHE_IL1,
+  CACHE_CONST,
+  CACHE_TLB
 } Cache_Type;
 
 /* set data pointers to this initially */
@@ -255,6 +259,12 @@ public:
    */
   bool invalidate_cache_line(Addr addr);
 
+  /**
+   * \brief Make a line the next victim of its set (streaming data)
+   * \param addr - address of the line
+   */
+  void set_evict_first(Addr addr);
+
   /**
    * \brief Function to return base cache line.
    * \param addr - Address
@@ -288,6 +298,29 @@ public:
    */
   void print_info(int id);
 
+  /**
+   * \brief Use an external clock for replacement timestamps instead of core 0's cycle
+   * \param clock - Pointer to the clock (NULL restores the default)
+   */
+  void set_clock(const sim_time_type *clock) {
+    m_clock = clock;
+  }
+
+  /**
+   * \brief Start recording every modified set so the updates can be rolled back
+   */
+  void begin_journal(void);
+
+  /**
+   * \brief Undo all updates made since begin_journal() and stop recording
+   */
+  void rollback_journal(void);
+
+  /**
+   * \brief Keep all updates made since begin_journal() and stop recording
+   */
+  void end_journal(void);
+
 public:
   Cache_Type m_cache_type; /**< cache type */
 
@@ -319,6 +352,31 @@ protected:
   cache_set_c **m_set; /**< cache data structure */
 
   macsim* m_simBase;
+  const sim_time_type *m_clock; /**< external replacement clock (NULL: core 0's cycle) */
+
+  /**
+   * Saved copy of a set, taken before its first update in a journal
+   */
+  struct journal_rec_s {
+    int set;
+    int num_cpu_line;
+    int num_gpu_line;
+    vector<cache_entry_c> entries;
+    vector<char> data;
+  };
+
+  bool m_journal_on; /**< record updates for rollback */
+  Counter m_journal_epoch; /**< current journal id */
+  vector<Counter> m_set_journal_epoch; /**< journal id in which a set was last saved */
+  vector<journal_rec_s> m_journal; /**< saved sets */
+  int m_journal_num_cpu_line; /**< m_num_cpu_line at begin_journal() */
+  int m_journal_num_gpu_line; /**< m_num_gpu_line at begin_journal() */
+  Counter m_journal_insert_count; /**< m_insert_count at begin_journal() */
+
+  /**
+   * Save a set before it is updated (if journaling)
+   */
+  void journal_set(int set);
 };
 
 #endif  // CACHE_H
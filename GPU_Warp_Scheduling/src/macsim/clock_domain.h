@@ -0,0 +1,51 @@
+#ifndef CLOCK_DOMAIN_H
+#define CLOCK_DOMAIN_H
+
+#include "sim_defs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// Clock of a domain (L2/interconnect, DRAM) relative to the core clock
+///
+/// The simulation advances in core cycles. A domain ticks cycles_at(c) times in the first c
+/// core cycles, and its cycle n ends within core cycle core_cycle_of(n), so events crossing
+/// into the core are seen at the first core edge after them. With the same frequency as the
+/// cores every conversion is the identity.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class clock_domain_c {
+public:
+  clock_domain_c(int mhz=1, int core_mhz=1) : m_mhz(mhz), m_core_mhz(core_mhz) {}
+
+  int mhz() const { return m_mhz; }
+  bool is_core_clock() const { return m_mhz == m_core_mhz; }
+
+  // Domain cycles elapsed after core_cycle core cycles
+  sim_time_type cycles_at(sim_time_type core_cycle) const {
+    return core_cycle * m_mhz / m_core_mhz;
+  }
+
+  // Core cycle in which domain cycle `cycle` ends
+  sim_time_type core_cycle_of(sim_time_type cycle) const {
+    return (cycle * m_core_mhz + m_mhz - 1) / m_mhz;
+  }
+
+  // Whether the domain has a clock edge during core cycle core_cycle
+  bool ticks_at(sim_time_type core_cycle) const {
+    return is_core_clock() || cycles_at(core_cycle) != cycles_at(core_cycle - 1);
+  }
+
+  // Latency of n domain cycles, in core cycles (rounded up)
+  sim_time_type core_cycles(sim_time_type n) const {
+    return core_cycle_of(n);
+  }
+
+  // Time of n domain cycles, in nanoseconds
+  double ns(sim_time_type n) const {
+    return n * 1000.0 / m_mhz;
+  }
+
+private:
+  int m_mhz;
+  int m_core_mhz;
+};
+
+#endif // CLOCK_DOMAIN_H
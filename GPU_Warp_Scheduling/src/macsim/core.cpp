@@ -6,6 +6,7 @@
 #include "cache.h"
 #include "ccws_vta.h"
 #include <limits>
+#include <type_traits>
 
 using namespace std;
 
@@ -21,7 +22,14 @@ do {                                                              \
   }                                                               \
 } while (0)
 
-#define CACHELOG(x) if(ENABLE_CACHE_LOG) {x}
+// CACHE_LOG is a template parameter of the specialized core pipeline (see core_c::select_run_a_cycle)
+#define CACHELOG(x) if(CACHE_LOG) {x}
+
+// Warp scheduling policies with a specialized core pipeline: add new policies here
+#define CORE_PIPELINE_POLICIES(X) \
+  X(ROUND_ROBIN)                  \
+  X(GTO)                          \
+  X(CCWS)
 
 
 core_c::core_c(macsim* gpusim, int core_id, sim_time_type cur_cycle)
@@ -31,20 +39,111 @@ core_c::core_c(macsim* gpusim, int core_id, sim_time_type cur_cycle)
   this->core_id = core_id;
   this->c_cycle = cur_cycle;
 
+  // Global parameters, or the overrides of this core
+  const core_config_s& cfg = gpusim->m_core_configs[core_id];
+
   ENABLE_CACHE = gpusim->m_gpu_params->Enable_GPU_Cache;
   ENABLE_CACHE_LOG = gpusim->m_gpu_params->GPU_Cache_Log;
+  c_policy = cfg.policy;
+  c_run_a_cycle = select_run_a_cycle(c_policy, ENABLE_CACHE, ENABLE_CACHE_LOG);
 
-  l1cache_size = gpusim->m_gpu_params->L1Cache_Size;
-  l1cache_assoc = gpusim->m_gpu_params->L1Cache_Assoc;
+  l1cache_size = cfg.l1cache_size;
+  l1cache_assoc = cfg.l1cache_assoc;
   l1cache_line_size = gpusim->m_gpu_params->L1Cache_Line_Size;
   l1cache_banks = gpusim->m_gpu_params->L1Cache_Banks;
 
+  c_n_schedulers = cfg.n_schedulers;
+  c_max_running_block_num = gpusim->max_block_per_core;
+  c_max_running_warp_num = cfg.max_warps;
+  if (gpusim->m_gpu_params->Enable_Occupancy_Model) {
+    // Blocks the kernel's resources allow, as far as their warps fit in the warp slots of the core
+    int warps_per_block = gpusim->kernel_info_v[gpusim->kernel_id].n_warp_per_block;
+    if (warps_per_block > 0)
+      c_max_running_block_num = std::min(c_max_running_block_num, std::max(1, cfg.max_warps / warps_per_block));
+    c_max_running_warp_num = std::min(cfg.max_warps, std::max(c_max_running_block_num * warps_per_block, c_n_schedulers));
+  }
+  c_warp_slots.resize(c_max_running_warp_num, c_n_schedulers);
+  c_sched_running_warps.assign(c_n_schedulers, NULL);
+  if (!gpusim->m_opcode_latency.empty())
+    c_opcode_latency = gpusim->m_opcode_latency.data();
+  c_non_blocking_loads = gpusim->m_gpu_params->Non_Blocking_Loads;
+  if (gpusim->m_gpu_params->Enable_Coalescer) {
+    c_coalescer_unit_size = gpusim->m_gpu_params->Coalescer_Sector_Size ? gpusim->m_gpu_params->Coalescer_Sector_Size
+                                                                         : l1cache_line_size;
+    c_coalescer_stride = gpusim->m_gpu_params->Coalescer_Thread_Stride;
+  }
+  c_barriers = gpusim->m_gpu_params->Enable_Barriers;
+  c_simt_stats = gpusim->m_gpu_params->Enable_SIMT_Stats;
+  c_l2_atomics = gpusim->m_gpu_params->Enable_L2_Atomics;
+  c_local_mem = gpusim->m_gpu_params->Enable_Local_Mem_Space;
+  c_local_l1_policy = gpusim->m_gpu_params->Local_Mem_L1_Policy;
+  c_cache_ops = gpusim->m_gpu_params->Enable_Cache_Operators;
+  c_energy_model = gpusim->m_gpu_params->Enable_Energy_Model;
+  if (gpusim->m_gpu_params->Enable_Func_Units) {
+    GPU_Parameter_Set* p = gpusim->m_gpu_params;
+    int fu_units[] = {p->FU_SP_Units, p->FU_DP_Units, p->FU_SFU_Units, p->FU_LDST_Units, p->FU_Tensor_Units};
+    int fu_ii[] = {p->FU_SP_II, p->FU_DP_II, p->FU_SFU_II, p->FU_LDST_II, p->FU_Tensor_II};
+    c_func_units = true;
+    c_fu_free_cycle.resize(NUM_FUNC_UNIT_TYPES);
+    for (int fu = 0; fu < NUM_FUNC_UNIT_TYPES; fu++) {
+      c_fu_free_cycle[fu].assign(fu_units[fu], 0);
+      c_fu_ii[fu] = std::max(fu_ii[fu], 1);
+    }
+  }
+  if (gpusim->m_gpu_params->Enable_Operand_Collector) {
+    ASSERTM(gpusim->m_gpu_params->RF_Banks > 0 && gpusim->m_gpu_params->RF_Bank_Read_Ports > 0 &&
+            gpusim->m_gpu_params->Collector_Units > 0, "Operand collector needs register banks, read ports and collector units");
+    c_rf_banks = gpusim->m_gpu_params->RF_Banks;
+    c_rf_port_free_cycle.assign(c_rf_banks, std::vector<sim_time_type>(gpusim->m_gpu_params->RF_Bank_Read_Ports, 0));
+    c_oc_free_cycle.assign(gpusim->m_gpu_params->Collector_Units, 0);
+  }
+  if (gpusim->m_gpu_params->Shared_Mem_Bank_Model) {
+    c_shmem_banks = gpusim->m_gpu_params->Shared_Mem_Banks;
+    c_shmem_bank_width = gpusim->m_gpu_params->Shared_Mem_Bank_Width;
+    c_shmem_stride = gpusim->m_gpu_params->Shared_Mem_Thread_Stride;
+    c_shmem_bank_words.assign(c_shmem_banks, 0);
+  }
+  if (gpusim->m_gpu_params->Enable_MSHR && ENABLE_CACHE) {
+    c_l1_mshr_entries = gpusim->m_gpu_params->L1_MSHR_Entries;
+    c_l1_mshr_merge_slots = gpusim->m_gpu_params->L1_MSHR_Merge_Slots;
+  }
+
+  // The last warp GTO scheduled on this core carries over from the previous kernel
+  c_gto_last_warp_id = gpusim->m_gto_last_warp_id[core_id];
+
   // Create L1 cache
   c_l1cache = new cache_c("dcache", l1cache_size, l1cache_assoc, l1cache_line_size,
                          sizeof(cache_data_t), l1cache_banks, false, core_id, CACHE_DL1, false, 1, 0, gpusim);
+
+  // Create L1 TLB (a line maps a page)
+  if (gpusim->m_gpu_params->Enable_TLB) {
+    c_page_size = gpusim->m_gpu_params->Page_Size;
+    c_l1_tlb = new cache_c("l1tlb", gpusim->m_gpu_params->L1_TLB_Sets, gpusim->m_gpu_params->L1_TLB_Assoc, c_page_size,
+                           sizeof(cache_data_t), 1, false, core_id, CACHE_TLB, false, 1, 0, gpusim);
+  }
+
+  // Create constant cache
+  if (gpusim->m_gpu_params->Enable_Const_Cache)
+    c_const_cache = new cache_c("ccache", gpusim->m_gpu_params->Const_Cache_Size, gpusim->m_gpu_params->Const_Cache_Assoc,
+                                gpusim->m_gpu_params->Const_Cache_Line_Size, sizeof(cache_data_t), 1, false, core_id,
+                                CACHE_CONST, false, 1, 0, gpusim);
+
+  // Create instruction cache
+  if (gpusim->m_gpu_params->Enable_ICache) {
+    c_icache_line_size = gpusim->m_gpu_params->ICache_Line_Size;
+    c_fetch_width = std::max(gpusim->m_gpu_params->Fetch_Width, 1);
+    c_ibuf_size = std::max(gpusim->m_gpu_params->Inst_Buffer_Size, 1);
+    c_fetch_rr.assign(c_n_schedulers, 0);
+    c_icache = new cache_c("icache", gpusim->m_gpu_params->ICache_Size, gpusim->m_gpu_params->ICache_Assoc,
+                           c_icache_line_size, sizeof(cache_data_t), 1, false, core_id, CACHE_IL1, false, 1, 0, gpusim);
+  }
 }
 
-core_c::~core_c(){}
+core_c::~core_c(){
+  delete c_icache;
+  delete c_const_cache;
+  delete c_l1_tlb;
+}
 
 void core_c::attach_l2_cache(cache_c * cache_ptr) {
   c_l2cache = cache_ptr;
@@ -67,19 +166,76 @@ sim_time_type core_c::get_stall_cycles(){
 }
 
 int core_c::get_running_warp_num(){
-  return c_dispatched_warps.size() + c_suspended_warps.size() + (c_running_warp ? 1 : 0);
+  return c_warp_slots.num_used();
 }
 
 int core_c::get_max_running_warp_num(){
   return c_max_running_warp_num;
 }
 
-void core_c::run_a_cycle(){
+bool core_c::has_suspended_warp_of_block(int block_id) {
+  if (c_warp_slots.num_suspended() + c_warp_slots.num_barrier() == 0) return false;
+  for (int slot = 0; slot < c_warp_slots.size(); slot++)
+    if ((c_warp_slots.is_suspended(slot) || c_warp_slots.state(slot) == Warp_Slot_State::BARRIER) &&
+        c_warp_slots.warp(slot)->block_id == block_id)
+      return true;
+  return false;
+}
+
+template <Warp_Scheduling_Policy_Types POLICY, bool CACHE_LOG>
+core_c::run_a_cycle_fn core_c::select_cache_mode(bool enable_cache) {
+  if (enable_cache)
+    return &core_c::run_a_cycle_impl<POLICY, true, CACHE_LOG>;
+  return &core_c::run_a_cycle_impl<POLICY, false, CACHE_LOG>;
+}
+
+core_c::run_a_cycle_fn core_c::select_run_a_cycle(Warp_Scheduling_Policy_Types policy, bool enable_cache,
+                                                  bool enable_cache_log) {
+  switch (policy) {
+#define CORE_PIPELINE_CASE(P)                                                                 \
+    case Warp_Scheduling_Policy_Types::P:                                                     \
+      return enable_cache_log ? select_cache_mode<Warp_Scheduling_Policy_Types::P, true>(enable_cache) \
+                              : select_cache_mode<Warp_Scheduling_Policy_Types::P, false>(enable_cache);
+    CORE_PIPELINE_POLICIES(CORE_PIPELINE_CASE)
+#undef CORE_PIPELINE_CASE
+    default:
+      ASSERTM(0, "Warp Scheduling Policy not valid!");
+      return NULL;
+  }
+}
+
+template <Warp_Scheduling_Policy_Types POLICY, bool CACHE, bool CACHE_LOG>
+void core_c::run_a_cycle_impl(){
   
+  // Idle until a memory response arrives: the cycle would only be a stall
+  if (!c_has_work) {
+    if (c_memory_responses.empty() && c_cycle <= 5000000000) {
+      c_cycle++;
+      stall_cycles++;
+      c_idle_cycles++;
+      return;
+    }
+
+    // Catch up on the LLS score decay of the idle cycles (every warp is suspended or at a barrier)
+    for (int slot = 0; slot < c_warp_slots.size(); slot++) {
+      if (c_warp_slots.state(slot) == Warp_Slot_State::FREE) continue;
+      warp_s* w = c_warp_slots.warp(slot);
+      int decay = (int)std::min<sim_time_type>(c_idle_cycles, w->ccws_lls_score);
+      w->ccws_lls_score = std::max(CCWS_LLS_BASE_SCORE, w->ccws_lls_score - decay);
+    }
+    c_idle_cycles = 0;
+    c_has_work = true;
+  }
+
   if (c_cycle > 5000000000) {
+    if (c_speculative) {
+      c_spec_aborted = true;
+      return;
+    }
     cout << "Core " << core_id << ", warps: ";
-    for (const auto& pair : c_suspended_warps) {
-      cout << pair.second->warp_id << " ";
+    for (int slot = 0; slot < c_warp_slots.size(); slot++) {
+      if (c_warp_slots.is_suspended(slot))
+        cout << c_warp_slots.warp(slot)->warp_id << " ";
     }
     cout << endl << "Deadlock" << endl;
     c_retire = true;
@@ -100,50 +256,67 @@ void core_c::run_a_cycle(){
     assert((w->ccws_lls_score) >= CCWS_LLS_BASE_SCORE);
   };
 
-  if (c_running_warp)
-    lls_decrement(c_running_warp);
-
-  for (auto& [_,w] : c_suspended_warps) lls_decrement(w);
-
-  for (auto& w : c_dispatched_warps) lls_decrement(w);
+  // Running, ready and suspended warps all hold a slot
+  for (int slot = 0; slot < c_warp_slots.size(); slot++)
+    if (c_warp_slots.state(slot) != Warp_Slot_State::FREE)
+      lls_decrement(c_warp_slots.warp(slot));
 
   //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
   // If we have memory response, move corresponding warp from suspended queue to dispatch queue
   while (!c_memory_responses.empty()){
-    if(c_suspended_warps.count(c_memory_responses.front()) > 0){
-
-      // remove from suspended queue
-      warp_s * ready_warp = c_suspended_warps[c_memory_responses.front()];
-      c_suspended_warps.erase(ready_warp->warp_id);
-      
-      // move to dispatch queue
-      c_dispatched_warps.push_back(ready_warp);
-
-      // clear memory response from memory response queue
-      c_memory_responses.pop();
-
-      WSLOG(printf("Warp ready: %x\n", ready_warp->warp_id);)
-    } else {
-      // memory response doesn't belong to any warp in dispatch queue: discard it 
-      c_memory_responses.pop();
+    core_mem_response_s resp = c_memory_responses.front();
+    c_memory_responses.pop();
+    if (resp.ifetch) {
+      icache_fill(resp.addr & ~INST_ADDR_BASE);
+      continue;
+    }
+    if (resp.tlb) {
+      // Every page of the instruction is translated: issue it again
+      tlb_fill(resp.addr);
+      warp_s* warp = c_warp_slots.warp(resp.slot_id);
+      if (--warp->tlb_walks_pending == 0 && c_warp_slots.is_suspended(resp.slot_id))
+        c_warp_slots.wake(resp.slot_id);
+      continue;
+    }
+    if (resp.slot_id >= 0)  // No warp waits for a prefetch
+      deliver_response(resp.slot_id, resp.dst_reg);
+
+    // The line is back: it answers the requests merged into its L1 MSHR entry too
+    if (c_l1_mshr_entries && resp.l1_miss) {
+      int idx = l1_mshr_find(resp.addr & ~(Addr)(l1cache_line_size - 1));
+      if (idx >= 0) {
+        std::vector<core_mem_response_s> waiters;
+        waiters.swap(c_l1_mshr[idx].waiters);
+        c_l1_mshr.erase(c_l1_mshr.begin() + idx);
+        for (const core_mem_response_s& w : waiters)
+          deliver_response(w.slot_id, w.dst_reg);
+      }
     }
   }
 
-  // Move currently executing warp to back of dispatch queue
-  if (c_running_warp != NULL) {
-    c_dispatched_warps.push_back(c_running_warp);
-    c_running_warp = NULL;
+  // Move currently executing warps to back of their dispatch queues
+  for (int sched = 0; sched < c_n_schedulers; sched++) {
+    if (c_sched_running_warps[sched] != NULL) {
+      c_warp_slots.push_ready(c_sched_running_warps[sched]->slot_id);
+      c_sched_running_warps[sched] = NULL;
+    }
   }
 
-  if (c_dispatched_warps.empty()) {
+  if (c_warp_slots.ready_empty()) {
+    // Block scheduling (and retiring) changes global state: stop speculating if it would do anything
+    if (c_speculative && (c_warp_slots.num_suspended() == 0 || gpusim->can_dispatch_warps(core_id))) {
+      c_spec_aborted = true;
+      return;
+    }
+
     // Schedule get warps from block scheduler into dispatched warp
     int ndispatched_warps = gpusim->dispatch_warps(core_id, gpusim->block_scheduling_policy);
     WSLOG(if(ndispatched_warps > 0)printf("Block scheduler: %d warps dispatched\n", ndispatched_warps);)
 
     // Retire the core if there are no more warps to run
-    if (c_dispatched_warps.empty() && c_suspended_warps.empty()){
+    if (c_warp_slots.num_used() == 0){
       c_retire = true;
       cout << "core " << core_id << " retired" << endl;
       return;
@@ -153,36 +326,95 @@ void core_c::run_a_cycle(){
   WSLOG(
   // Print queues
   printf("[%ld,%d]: DQ[", c_cycle, core_id);
-  unsigned _indx=0;
-  for (auto x: c_dispatched_warps){
-    printf("%x:%d%s", x->warp_id, x->ccws_lls_score, (_indx++ != c_dispatched_warps.size()-1?", ":""));
+  for (int sched = 0; sched < c_n_schedulers; sched++){
+    if (sched > 0) printf(" | ");
+    for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)){
+      warp_s* x = c_warp_slots.warp(slot);
+      printf("%x:%d%s", x->warp_id, x->ccws_lls_score, (c_warp_slots.next_ready(slot) != -1?", ":""));
+    }
   }
-  printf("] SQ["); _indx=0;
-  for (auto x: c_suspended_warps){
-    printf("%x:%d%s", x.first, x.second->ccws_lls_score, (_indx++ != c_suspended_warps.size()-1?", ":""));
+  printf("] SQ[");
+  int _n_suspended=0;
+  for (int slot = 0; slot < c_warp_slots.size(); slot++){
+    if (!c_warp_slots.is_suspended(slot)) continue;
+    warp_s* x = c_warp_slots.warp(slot);
+    printf("%x:%d%s", x->warp_id, x->ccws_lls_score, (++_n_suspended != c_warp_slots.num_suspended()?", ":""));
   }
   printf("]\n");
   )
 
   CCWSLOG(
   // Print VTAs
-  for(auto W: c_dispatched_warps){
-    printf("dVTA warp:%x: [", W->warp_id);
-    W->ccws_vta_entry->print();
-    printf("]\n");
+  for (int sched = 0; sched < c_n_schedulers; sched++){
+    for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)){
+      warp_s* W = c_warp_slots.warp(slot);
+      printf("dVTA warp:%x: [", W->warp_id);
+      W->ccws_vta_entry->print();
+      printf("]\n");
+    }
   }
-  for(auto W: c_suspended_warps){
-    printf("sVTA warp:%x: [", W.first);
-    W.second->ccws_vta_entry->print();
+  for (int slot = 0; slot < c_warp_slots.size(); slot++){
+    if (!c_warp_slots.is_suspended(slot)) continue;
+    warp_s* W = c_warp_slots.warp(slot);
+    printf("sVTA warp:%x: [", W->warp_id);
+    W->ccws_vta_entry->print();
     printf("]\n");
   }
   )
 
-  // Schedule a warp
-  bool skip_cycle = schedule_warps(gpusim->warp_scheduling_policy);
+  // Each warp scheduler fetches for its own warp slots
+  c_fetch_busy = false;
+  if (c_icache)
+    for (int sched = 0; sched < c_n_schedulers; sched++)
+      fetch(sched);
+
+  // Each warp scheduler issues from its own warp slots
+  bool skip_cycle = true;
+  for (int sched = 0; sched < c_n_schedulers; sched++) {
+    if (issue_warp<POLICY, CACHE, CACHE_LOG>(sched))
+      skip_cycle = false;
+    if (c_spec_aborted)
+      return;
+  }
+
   if(skip_cycle) {
     stall_cycles++;
-    return;
+
+    // Nothing but LLS score decay can happen until a memory response arrives (no warp to
+    // schedule, no block to dispatch): skip the following cycles. Logs print every cycle.
+#if !defined(LOG_WARP_SCHEDULING) && !defined(LOG_CCWS_WARP_SCHEDULING)
+    if (c_warp_slots.ready_empty() && !c_fetch_busy)
+      c_has_work = false;
+#endif
+  }
+}
+
+template <Warp_Scheduling_Policy_Types POLICY, bool CACHE, bool CACHE_LOG>
+bool core_c::issue_warp(int sched) {
+  // Schedule a warp
+  c_running_warp = NULL;
+  c_mshr_blocked = false;
+  c_ldst_blocked = false;
+  c_fu_blocked = -1;
+  c_fetch_blocked = false;
+  c_oc_blocked = false;
+  bool skip_cycle = schedule_warps<POLICY>(sched);
+  if(skip_cycle) {
+    if (!c_warp_slots.ready_empty(sched)) {
+      if (c_fetch_blocked)
+        c_fetch_stalls++;
+      else if (c_fu_blocked >= 0)
+        c_fu_stalls[c_fu_blocked]++;
+      else if (c_oc_blocked)
+        c_oc_stalls++;
+      else if (c_mshr_blocked)
+        c_mshr_stalls++;
+      else if (c_ldst_blocked)
+        c_ldst_stalls++;
+      else
+        c_dep_stalls++;
+    }
+    return false;
   }
 
   WSLOG(printf("Warp scheduled: %x\n", c_running_warp->warp_id);)
@@ -194,126 +426,686 @@ void core_c::run_a_cycle(){
     ASSERTM(0, "error opening trace file");
 
   // refill trace buffer for the warp if empty
-  if(c_running_warp->trace_buffer.empty()) {
-    bool reached_eof = gzeof(c_running_warp->m_trace_file);
-   
-    if (!reached_eof) {
-      // Try to refill trace buffer
-      unsigned tmp_buf_sz = c_running_warp->trace_buffer_size * TRACE_SIZE;
-      char tmp_buf [tmp_buf_sz];
-      unsigned bytes_read = gzread(c_running_warp->m_trace_file, tmp_buf, tmp_buf_sz);
-      unsigned num_of_insts_read = bytes_read / TRACE_SIZE;
-
-      if (num_of_insts_read == 0) // we reached end of file
-        reached_eof = true;
-
-      for(unsigned i=0; i<num_of_insts_read; i++) {
-        trace_info_nvbit_small_s * trace_info = new trace_info_nvbit_small_s;
-        memcpy(trace_info, &tmp_buf[i*TRACE_SIZE], TRACE_SIZE);
-        c_running_warp->trace_buffer.push(trace_info);
-      }
+  if(c_running_warp->trace_buffer.empty() && !refill_trace_buffer(c_running_warp)) {
+    if (c_speculative) {
+      c_spec_aborted = true;
+      return true;
     }
 
-  if(reached_eof) {
-      // No instructions to execute in buffer and we reached end of trace file: close file
-      gzclose(c_running_warp->m_trace_file);
-      WSLOG(printf("Warp finished: %x\n", c_running_warp->warp_id);)
-      delete c_running_warp;
-      c_running_warp = NULL;
-      return;
+    // No instructions to execute in buffer and we reached end of trace file: close file
+    gzclose(c_running_warp->m_trace_file);
+    WSLOG(printf("Warp finished: %x\n", c_running_warp->warp_id);)
+    c_warp_slots.remove(c_running_warp->slot_id);
+
+    if (c_simt_stats && c_running_warp->simt_insts > 0) {
+      double eff = (double)c_running_warp->simt_active_lanes / (32.0 * c_running_warp->simt_insts);
+      c_simt_warps++;
+      c_min_warp_simt_eff = std::min(c_min_warp_simt_eff, eff);
+      c_max_warp_simt_eff = std::max(c_max_warp_simt_eff, eff);
+      c_sum_warp_simt_eff += eff;
+      c_warp_simt_eff[std::min((int)(eff * SIMT_EFF_BUCKETS), SIMT_EFF_BUCKETS - 1)]++;
+    }
+
+    // Barriers of the block no longer wait for the warp
+    if (c_barriers) {
+      block_schedule_info_s* block = gpusim->m_block_schedule_info.at(c_running_warp->block_id);
+      block->finished_warp_num++;
+      for (int id = 0; id < MAX_BLOCK_BARRIERS; id++)
+        if (block->barriers[id].arrived_warps > 0 && barrier_complete(block, block->barriers[id]))
+          release_barrier(c_running_warp->block_id, id);
     }
+    delete c_running_warp;
+    c_running_warp = NULL;
+    return true;
   }
 
   // pop one instruction, and execute it
   trace_info_nvbit_small_s *trace_info = c_running_warp->trace_buffer.front();
+  bool is_atomic = c_l2_atomics && is_global_atomic(trace_info->m_opcode);
+  bool is_global_mem = (is_ld(trace_info->m_opcode) || is_st(trace_info->m_opcode) || is_atomic) &&
+                       !is_using_shared_memory(trace_info->m_opcode);
+
+  // Address translation: the warp waits for its L1 TLB misses, then issues the instruction again
+  // (before it takes a functional unit, reads its operands or prefetches)
+  if (c_l1_tlb && is_global_mem) {
+    if (!c_running_warp->tlb_translated) {
+      int walks = translate(trace_info);
+      if (walks > 0) {
+        c_running_warp->tlb_walks_pending = walks;
+        c_running_warp->tlb_translated = true;
+        c_warp_slots.suspend(c_running_warp->slot_id);
+        c_running_warp = NULL;
+        return true;
+      }
+    }
+    c_running_warp->tlb_translated = false;
+  }
+
+  // The instruction takes an instance of its functional unit for the initiation interval
+  if (c_func_units) {
+    int fu = (int)get_func_unit(get_exec_unit(trace_info->m_opcode));
+    if (fu != (int)Func_Unit_Types::NONE) {
+      int unit = free_func_unit(fu);
+      assert(unit >= 0);
+      c_fu_free_cycle[fu][unit] = c_cycle + c_fu_ii[fu];
+      c_fu_issued[fu]++;
+    }
+  }
+
+  // Operands are read before execution: bank conflicts delay the result
+  int operand_cycles = 0;
+  if (c_rf_banks)
+    operand_cycles = collect_operands(c_running_warp, trace_info);
   
   //---------- Execute instruction ----------
-  if((is_ld(trace_info->m_opcode) || is_st(trace_info->m_opcode)) && !is_using_shared_memory(trace_info->m_opcode)) {
+  if (CACHE && c_cache_ops && is_prefetch(trace_info))
+    prefetch(trace_info);
+  if (is_global_mem) {
     // Load/Store Op: Send request to memory hierarchy
     CACHELOG(printf("==[Cycle: %ld]============================================\n", c_cycle);)
     CACHELOG(printf("Cache Access: Wid: %x, Addr: 0x%016lx, Wr: %d\n", c_running_warp->warp_id, trace_info->m_mem_addr, is_st(trace_info->m_opcode));)
-    bool suspend_warp = send_mem_req(c_running_warp->warp_id, trace_info, ENABLE_CACHE);
-    if(suspend_warp) {
-      // Memory request initiated, need to suspend without committing
+    int n_requests;
+    if (is_atomic) {
+      // Atomic: executed at the L2, unless its results already returned to the suspended warp
+      n_requests = c_running_warp->atomic_returned ? 0 : send_atomic_req(trace_info);
+      c_running_warp->atomic_returned = false;
+    } else {
+      n_requests = send_mem_req<CACHE, CACHE_LOG>(c_running_warp->warp_id, trace_info);
+    }
+    if(n_requests > 0 && c_non_blocking_loads) {
+      // Memory requests initiated: commit, the destination registers are pending until the responses
+      c_running_warp->n_mem_pending += n_requests;
+      if ((trace_info->m_is_load || is_atomic) && trace_info->m_num_dest_regs > 0) {
+        pending_load_s load;
+        load.n_wait = n_requests;
+        load.n_dst = std::min<int>(trace_info->m_num_dest_regs, MAX_NVBIT_DST_NUM);
+        for (int i = 0; i < load.n_dst; i++) {
+          load.dst[i] = trace_info->m_dst[i];
+          if (load.dst[i] >= c_running_warp->reg_ready_cycle.size())
+            c_running_warp->reg_ready_cycle.resize(load.dst[i] + 1, 0);
+          c_running_warp->reg_ready_cycle[load.dst[i]] = PENDING_LOAD_CYCLE;
+        }
+        c_running_warp->pending_loads.push_back(load);
+      }
+      if (c_simt_stats)
+        simt_account(c_running_warp, trace_info);
+      if (c_energy_model)
+        c_energy_insts[(int)get_func_unit(get_exec_unit(trace_info->m_opcode))]++;
+      c_running_warp->trace_buffer.pop_front();
+      if (c_icache)
+        c_running_warp->ibuf_insts--;
+      inst_count_total++;
+      return issue_done(sched);
+    }
+    if(n_requests > 0) {
+      // Memory request initiated, need to suspend without committing (until every response returned)
       WSLOG(printf("Warp suspended: %x\n", c_running_warp->warp_id);)
-      c_suspended_warps[c_running_warp->warp_id] = c_running_warp;
+      c_running_warp->n_mem_pending = n_requests;
+      c_running_warp->atomic_returned = is_atomic;
+      c_warp_slots.suspend(c_running_warp->slot_id);
       c_running_warp = NULL;
-      return;
+      return true;
     } 
   }
 
+  // Shared memory access: bank conflicts replay it, holding the LD/ST pipe
+  int replay_cycles = 0;
+  if (c_shmem_banks && is_using_shared_memory(trace_info->m_opcode)) {
+    int wavefronts = shmem_wavefronts(trace_info);
+    replay_cycles = wavefronts - 1;
+    c_ldst_free_cycle = c_cycle + wavefronts;
+  }
+
   // Commit otherwise (non suspending ld/st OR any other instruction)
-  c_running_warp->trace_buffer.pop();
+  if (c_opcode_latency)
+    scoreboard_issue(c_running_warp, trace_info, replay_cycles + operand_cycles);
+  if (c_simt_stats)
+    simt_account(c_running_warp, trace_info);
+  if (c_energy_model)
+    c_energy_insts[(int)get_func_unit(get_exec_unit(trace_info->m_opcode))]++;
+  c_running_warp->trace_buffer.pop_front();
+  if (c_icache)
+    c_running_warp->ibuf_insts--;
   inst_count_total++;
+  if (c_barriers && trace_info->m_opcode == BAR)
+    return arrive_at_barrier(sched, trace_info->m_barrier_id, trace_info->m_num_barrier_threads);
+  return issue_done(sched);
+}
+
+void core_c::simt_account(warp_s* warp, trace_info_nvbit_small_s* trace_info) {
+  // A partially active instruction still takes a whole issue slot: inactive lanes are lost
+  int lanes = __builtin_popcount(trace_info->m_active_mask);
+  warp->simt_insts++;
+  warp->simt_active_lanes += lanes;
+  c_simt_insts++;
+  c_simt_active_lanes += lanes;
+
+  if (trace_info->m_opcode == BRA || trace_info->m_opcode == BRX || trace_info->m_opcode == BRXU) {
+    c_branches++;
+    uint32_t taken = trace_info->m_br_taken_mask & trace_info->m_active_mask;
+    if (taken != 0 && taken != trace_info->m_active_mask)
+      c_divergent_branches++;
+  }
+
+  simt_pc_stats_s& pc = (c_speculative ? c_spec_simt_pc_stats : c_simt_pc_stats)[trace_info->m_inst_addr];
+  pc.insts++;
+  pc.active_lanes += lanes;
+}
+
+bool core_c::arrive_at_barrier(int sched, int barrier_id, int n_threads) {
+  int block_id = c_running_warp->block_id;
+  block_schedule_info_s* block = gpusim->m_block_schedule_info.at(block_id);
+  barrier_id %= MAX_BLOCK_BARRIERS;
+  block_barrier_s& barrier = block->barriers[barrier_id];
+
+  // The first warp to arrive sets the participants: n_threads threads, or the whole block (0)
+  if (barrier.arrived_warps++ == 0)
+    barrier.expected_warps = (n_threads + 31) / 32;
+
+  if (!barrier_complete(block, barrier)) {
+    WSLOG(printf("Warp at barrier: %x\n", c_running_warp->warp_id);)
+    c_running_warp->barrier_id = barrier_id;
+    c_running_warp->barrier_wait_start = c_cycle;
+    c_warp_slots.wait_barrier(c_running_warp->slot_id);
+    c_barrier_waits++;
+    c_running_warp = NULL;
+    return true;
+  }
+
+  // Last to arrive: go on with the others
+  release_barrier(block_id, barrier_id);
+  return issue_done(sched);
+}
+
+bool core_c::barrier_complete(block_schedule_info_s* block, const block_barrier_s& barrier) {
+  // Warps that finished don't arrive: wait for the live ones only
+  int live_warps = block->dispatched_thread_num - block->finished_warp_num;
+  int expected = barrier.expected_warps ? std::min(barrier.expected_warps, live_warps) : live_warps;
+  return barrier.arrived_warps >= expected;
+}
+
+void core_c::release_barrier(int block_id, int barrier_id) {
+  gpusim->m_block_schedule_info.at(block_id)->barriers[barrier_id] = block_barrier_s();
+  c_barriers_released++;
+  if (c_warp_slots.num_barrier() == 0)
+    return;
+
+  for (int slot = 0; slot < c_warp_slots.size(); slot++) {
+    warp_s* warp = c_warp_slots.warp(slot);
+    if (c_warp_slots.state(slot) != Warp_Slot_State::BARRIER || warp->block_id != block_id ||
+        warp->barrier_id != barrier_id)
+      continue;
+    WSLOG(printf("Warp ready: %x\n", warp->warp_id);)
+    c_barrier_wait_cycles += c_cycle - warp->barrier_wait_start;
+    warp->barrier_id = -1;
+
+    // Non-blocking loads: the next instruction may use a register still in memory
+    bool suspend = c_non_blocking_loads && waits_on_load(warp);
+    if (suspend)
+      c_load_use_stalls++;
+    c_warp_slots.release_barrier(slot, suspend);
+  }
+}
+
+bool core_c::issue_done(int sched) {
+  // Non-blocking loads: wait for memory before the first use of a pending register
+  if (c_non_blocking_loads && waits_on_load(c_running_warp)) {
+    WSLOG(printf("Warp suspended: %x\n", c_running_warp->warp_id);)
+    c_load_use_stalls++;
+    c_warp_slots.suspend(c_running_warp->slot_id);
+    c_running_warp = NULL;
+    return true;
+  }
+
+  c_sched_running_warps[sched] = c_running_warp;
+  c_running_warp = NULL;
+  return true;
+}
+
+void core_c::deliver_response(int slot, int dst_reg) {
+  if (c_non_blocking_loads) {
+    // The warp can't finish with requests in flight, so the slot still holds it
+    warp_s* warp = c_warp_slots.warp(slot);
+    if (warp) {
+      complete_mem_request(warp, dst_reg);
+      if (c_warp_slots.is_suspended(slot) && !waits_on_load(warp)) {
+        c_warp_slots.wake(slot);
+        WSLOG(printf("Warp ready: %x\n", warp->warp_id);)
+      }
+    }
+  } else if(c_warp_slots.is_suspended(slot)){
+    // move from suspended queue to dispatch queue once every request of the instruction returned
+    if (--c_warp_slots.warp(slot)->n_mem_pending == 0) {
+      c_warp_slots.wake(slot);
+      WSLOG(printf("Warp ready: %x\n", c_warp_slots.warp(slot)->warp_id);)
+    }
+  }
+  // otherwise the memory response doesn't belong to any suspended warp: discard it
+}
+
+int core_c::l1_mshr_find(Addr line_addr) {
+  for (int i = 0; i < (int)c_l1_mshr.size(); i++)
+    if (c_l1_mshr[i].line_addr == line_addr)
+      return i;
+  return -1;
+}
+
+bool core_c::l1_mshr_can_accept(warp_s* warp, trace_info_nvbit_small_s* trace_info) {
+  if (!is_ld(trace_info->m_opcode) || is_using_shared_memory(trace_info->m_opcode))
+    return true;
+  if (c_const_cache && get_mem_space(trace_info) == Mem_Space_Types::CONSTANT)
+    return true;
+
+  // Lines of the request (hits are not known before the access: count every line as a miss)
+  Addr line_mask = ~(Addr)(l1cache_line_size - 1);
+  Addr addr = mem_addr(warp, trace_info);
+  std::vector<Addr> lines;
+  if (c_coalescer_unit_size) {
+    coalesce(trace_info, addr);
+    for (Addr unit_addr : c_coalesced_units)
+      lines.push_back(unit_addr & line_mask);
+  } else {
+    lines.push_back(addr & line_mask);
+  }
+
+  // A new entry per line without one, a merge slot per line with one (the accesses of an instruction
+  // to a line merge together)
+  int n_new = 0;
+  for (size_t i = 0; i < lines.size(); i++) {
+    if (i > 0 && lines[i] == lines[i - 1])
+      continue;
+    int idx = l1_mshr_find(lines[i]);
+    if (idx < 0)
+      n_new++;
+    else if ((int)c_l1_mshr[idx].waiters.size() >= c_l1_mshr_merge_slots)
+      return false;
+  }
+
+  // An instruction touching more lines than there are entries issues into an empty MSHR
+  if (c_l1_mshr.empty())
+    return true;
+  return (int)c_l1_mshr.size() + n_new <= c_l1_mshr_entries;
+}
+
+bool core_c::refill_trace_buffer(warp_s* warp) {
+  // Instructions already read by a rolled back speculative window come first, in the same chunks
+  if (!warp->trace_replay_buffer.empty()) {
+    for (unsigned i = 0; i < warp->trace_buffer_size && !warp->trace_replay_buffer.empty(); i++) {
+      warp->trace_buffer.push_back(warp->trace_replay_buffer.front());
+      warp->trace_replay_buffer.pop_front();
+    }
+    return true;
+  }
+
+  if (gzeof(warp->m_trace_file))
+    return false;
+
+  // Try to refill trace buffer
+  unsigned tmp_buf_sz = warp->trace_buffer_size * TRACE_SIZE;
+  char tmp_buf [tmp_buf_sz];
+  unsigned bytes_read = gzread(warp->m_trace_file, tmp_buf, tmp_buf_sz);
+  unsigned num_of_insts_read = bytes_read / TRACE_SIZE;
+
+  if (num_of_insts_read == 0) // we reached end of file
+    return false;
+
+  for(unsigned i=0; i<num_of_insts_read; i++) {
+    trace_info_nvbit_small_s * trace_info = new trace_info_nvbit_small_s;
+    memcpy(trace_info, &tmp_buf[i*TRACE_SIZE], TRACE_SIZE);
+    warp->trace_buffer.push_back(trace_info);
+    if (c_speculative)
+      warp->spec_trace_reads.push_back(trace_info);
+  }
+  return true;
+}
+
+bool core_c::can_issue(warp_s* warp) {
+  if (!c_opcode_latency && !c_l1_mshr_entries && !c_func_units && !c_icache && !c_rf_banks &&
+      c_cycle >= c_ldst_free_cycle)
+    return true;
+
+  // A warp at the end of its trace is scheduled to finish
+  if (warp->trace_buffer.empty() && !refill_trace_buffer(warp))
+    return true;
+
+  // The next instruction has not been fetched yet
+  if (c_icache && warp->ibuf_insts == 0) {
+    c_fetch_blocked = true;
+    return false;
+  }
+
+  trace_info_nvbit_small_s* trace_info = warp->trace_buffer.front();
+  if (c_func_units) {
+    int fu = (int)get_func_unit(get_exec_unit(trace_info->m_opcode));
+    if (fu != (int)Func_Unit_Types::NONE && free_func_unit(fu) < 0) {
+      c_fu_blocked = fu;
+      return false;
+    }
+  }
+  if (c_rf_banks && trace_info->m_num_read_regs > 0 && free_collector_unit() < 0) {
+    c_oc_blocked = true;
+    return false;
+  }
+  if (c_cycle < c_ldst_free_cycle &&
+      (is_ld(trace_info->m_opcode) || is_st(trace_info->m_opcode) || is_using_shared_memory(trace_info->m_opcode))) {
+    c_ldst_blocked = true;
+    return false;
+  }
+  if (c_l1_mshr_entries && !l1_mshr_can_accept(warp, trace_info)) {
+    c_mshr_blocked = true;
+    return false;
+  }
+  if (!c_opcode_latency)
+    return true;
+
+  const std::vector<sim_time_type>& ready = warp->reg_ready_cycle;
+  for (int i = 0; i < trace_info->m_num_read_regs && i < MAX_NVBIT_SRC_NUM; i++) {
+    uint16_t reg = trace_info->m_src[i];
+    if (reg < ready.size() && ready[reg] > c_cycle)
+      return false;
+  }
+  for (int i = 0; i < trace_info->m_num_dest_regs && i < MAX_NVBIT_DST_NUM; i++) {
+    uint16_t reg = trace_info->m_dst[i];
+    if (reg < ready.size() && ready[reg] > c_cycle)
+      return false;
+  }
+  return true;
+}
+
+void core_c::scoreboard_issue(warp_s* warp, trace_info_nvbit_small_s* trace_info, int extra_cycles) {
+  sim_time_type ready_cycle = c_cycle + c_opcode_latency[trace_info->m_opcode] + extra_cycles;
+  for (int i = 0; i < trace_info->m_num_dest_regs && i < MAX_NVBIT_DST_NUM; i++) {
+    uint16_t reg = trace_info->m_dst[i];
+    if (reg >= warp->reg_ready_cycle.size())
+      warp->reg_ready_cycle.resize(reg + 1, 0);
+    warp->reg_ready_cycle[reg] = ready_cycle;
+  }
 }
 
-bool core_c::schedule_warps(Warp_Scheduling_Policy_Types policy) {
-  // Select warp scheduling policy
-  switch(policy) {
+bool core_c::waits_on_load(warp_s* warp) {
+  if (warp->tlb_walks_pending > 0)
+    return true;
+  if (warp->n_mem_pending == 0)
+    return false;
+  if (warp->trace_buffer.empty() && !refill_trace_buffer(warp))
+    return true;
+
+  trace_info_nvbit_small_s* trace_info = warp->trace_buffer.front();
+  const std::vector<sim_time_type>& ready = warp->reg_ready_cycle;
+  for (int i = 0; i < trace_info->m_num_read_regs && i < MAX_NVBIT_SRC_NUM; i++) {
+    uint16_t reg = trace_info->m_src[i];
+    if (reg < ready.size() && ready[reg] == PENDING_LOAD_CYCLE)
+      return true;
+  }
+  for (int i = 0; i < trace_info->m_num_dest_regs && i < MAX_NVBIT_DST_NUM; i++) {
+    uint16_t reg = trace_info->m_dst[i];
+    if (reg < ready.size() && ready[reg] == PENDING_LOAD_CYCLE)
+      return true;
+  }
+  return false;
+}
+
+void core_c::complete_mem_request(warp_s* warp, int dst_reg) {
+  warp->n_mem_pending--;
+  if (dst_reg < 0)
+    return;
+  for (auto it = warp->pending_loads.begin(); it != warp->pending_loads.end(); ++it) {
+    if (it->dst[0] == dst_reg) {
+      if (--it->n_wait > 0)
+        return;
+      for (int i = 0; i < it->n_dst; i++)
+        warp->reg_ready_cycle[it->dst[i]] = c_cycle;
+      warp->pending_loads.erase(it);
+      return;
+    }
+  }
+}
+
+void core_c::repair_l1_miss(Addr addr, int slot_id, bool evict_first) {
+  Addr line_addr, victim_line_addr;
+  c_l1cache->insert_cache(addr, &line_addr, &victim_line_addr, 0, false);
+  if (evict_first)
+    c_l1cache->set_evict_first(addr);
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // TODO: Task 2.1b: Insert the tag in warp's VTA entry upon L1 eviction.
+  // Steps:
+  //  - Get tag corresponding to the address. (see if any of the cache class methods can help with this)
+  //  - Search for the warp that issued the request in core's suspended queue and Insert the tag in warp's VTA entry
+  if(victim_line_addr && slot_id >= 0) {
+    // Get the tag from the address
+    Addr repl_ln_tag;
+    int dummy_set;
+    c_l1cache->find_tag_and_set(victim_line_addr, &repl_ln_tag, &dummy_set);
+
+    // Get the warp pointer from suspended queue and insert the tag into the warp's VTA
+    warp_s* warp = c_warp_slots.warp(slot_id);
+    warp->ccws_vta_entry->insert(repl_ln_tag);
+    CCWSLOG(printf("VTA insertion: %llx\n", repl_ln_tag));
+  }
+  //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+bool core_c::access_l2(Addr addr, bool is_write) {
+  Addr line_addr;
+
+  // While speculating, L2 is only looked up; the access is replayed (and checked) at commit
+  if (c_speculative) {
+    bool l2_hit = c_l2cache->access_cache(addr, &line_addr, false, 0) != NULL;
+    spec_event_s event = {};
+    event.cycle = c_spec_cycle;
+    event.is_mem_req = false;
+    event.addr = addr;
+    event.is_write = is_write;
+    event.l2_hit = l2_hit;
+    c_spec_log.push_back(event);
+    return l2_hit;
+  }
+
+  cache_data_t * l2_access_data = (cache_data_t*) c_l2cache->access_cache(addr, &line_addr, true, 0);
+  gpusim->count_l2_access(l2_access_data != NULL);
+  if (l2_access_data && is_write)
+    l2_access_data->m_dirty = true;
+  return l2_access_data != NULL;
+}
+
+void core_c::send_mem_event(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz, bool on_response_insert_in_l1,
+                            bool on_response_mark_dirty, bool on_response_insert_in_const) {
+  if (c_speculative) {
+    spec_event_s event = {};
+    event.cycle = c_spec_cycle;
+    event.is_mem_req = true;
+    event.trace_info = trace_info;
+    event.addr = addr;
+    event.access_sz = access_sz;
+    event.block_id = c_running_warp->block_id;
+    event.warp_id = c_running_warp->warp_id;
+    event.slot_id = c_running_warp->slot_id;
+    event.insert_in_l1 = on_response_insert_in_l1;
+    event.mark_dirty = on_response_mark_dirty;
+    c_spec_log.push_back(event);
+    return;
+  }
+
+  gpusim->inst_event(trace_info, addr, access_sz, core_id, c_running_warp->block_id, c_running_warp->warp_id, c_running_warp->slot_id, c_cycle,
+                     on_response_insert_in_l1, on_response_mark_dirty, on_response_insert_in_const);
+}
+
+void core_c::save_checkpoint() {
+  // The checkpoint copies must have the types of the members
+#define CORE_CHECKPOINT_FIELD(type, name) \
+  static_assert(std::is_same<decltype(name), type>::value, "checkpoint type of core_c::" #name);
+#define CORE_CHECKPOINT_ARRAY(type, name, n) \
+  static_assert(std::is_same<decltype(name), type[n]>::value, "checkpoint type of core_c::" #name);
+  CORE_CHECKPOINT_FIELDS(CORE_CHECKPOINT_FIELD)
+  CORE_CHECKPOINT_ARRAYS(CORE_CHECKPOINT_ARRAY)
+#undef CORE_CHECKPOINT_FIELD
+#undef CORE_CHECKPOINT_ARRAY
+
+  core_checkpoint_s& ckpt = c_checkpoint;
+#define CORE_CHECKPOINT_FIELD(type, name) ckpt.name = name;
+#define CORE_CHECKPOINT_ARRAY(type, name, n) std::copy(name, name + (n), ckpt.name);
+  CORE_CHECKPOINT_FIELDS(CORE_CHECKPOINT_FIELD)
+  CORE_CHECKPOINT_ARRAYS(CORE_CHECKPOINT_ARRAY)
+#undef CORE_CHECKPOINT_FIELD
+#undef CORE_CHECKPOINT_ARRAY
+
+  // Speculation never dispatches or finishes warps, so the warps on the core stay the same
+  ckpt.warps.clear();
+  auto save_warp = [&ckpt](warp_s* w) {
+    warp_checkpoint_s wc = {w, w->ccws_lls_score, *w->ccws_vta_entry, w->trace_buffer, w->trace_replay_buffer,
+                         w->reg_ready_cycle, w->n_mem_pending, w->pending_loads, w->barrier_id,
+                         w->barrier_wait_start, w->simt_insts, w->simt_active_lanes};
+    ckpt.warps.push_back(wc);
+    w->spec_trace_reads.clear();
+  };
+  for (int slot = 0; slot < c_warp_slots.size(); slot++)
+    if (c_warp_slots.state(slot) != Warp_Slot_State::FREE)
+      save_warp(c_warp_slots.warp(slot));
+
+  // Barriers of the blocks on the core (only this core's warps arrive at them)
+  ckpt.barriers.clear();
+  if (c_barriers) {
+    for (int slot = 0; slot < c_warp_slots.size(); slot++) {
+      if (c_warp_slots.state(slot) == Warp_Slot_State::FREE)
+        continue;
+      block_schedule_info_s* block = gpusim->m_block_schedule_info.at(c_warp_slots.warp(slot)->block_id);
+      auto saved = [block](const block_checkpoint_s& b) { return b.block == block; };
+      if (std::none_of(ckpt.barriers.begin(), ckpt.barriers.end(), saved)) {
+        ckpt.barriers.emplace_back();
+        ckpt.barriers.back().block = block;
+        std::copy(block->barriers, block->barriers + MAX_BLOCK_BARRIERS, ckpt.barriers.back().barriers);
+      }
+    }
+  }
+
+  c_spec_log.clear();
+  c_spec_n_cache_req = 0;
+  c_spec_n_l1_hits = 0;
+  c_spec_aborted = false;
+  c_l1cache->begin_journal();
+}
+
+void core_c::restore_checkpoint() {
+  core_checkpoint_s& ckpt = c_checkpoint;
+#define CORE_CHECKPOINT_FIELD(type, name) name = ckpt.name;
+#define CORE_CHECKPOINT_ARRAY(type, name, n) std::copy(ckpt.name, ckpt.name + (n), name);
+  CORE_CHECKPOINT_FIELDS(CORE_CHECKPOINT_FIELD)
+  CORE_CHECKPOINT_ARRAYS(CORE_CHECKPOINT_ARRAY)
+#undef CORE_CHECKPOINT_FIELD
+#undef CORE_CHECKPOINT_ARRAY
+  c_spec_simt_pc_stats.clear();
+
+  for (auto& b : ckpt.barriers)
+    std::copy(b.barriers, b.barriers + MAX_BLOCK_BARRIERS, b.block->barriers);
+
+  for (auto& wc : ckpt.warps) {
+    warp_s* w = wc.warp;
+    w->ccws_lls_score = wc.ccws_lls_score;
+    *w->ccws_vta_entry = wc.vta;
+    w->trace_buffer = wc.trace_buffer;
+    w->reg_ready_cycle = wc.reg_ready_cycle;
+    w->n_mem_pending = wc.n_mem_pending;
+    w->pending_loads = wc.pending_loads;
+    w->barrier_id = wc.barrier_id;
+    w->barrier_wait_start = wc.barrier_wait_start;
+    w->simt_insts = wc.simt_insts;
+    w->simt_active_lanes = wc.simt_active_lanes;
+
+    // The trace file can't be rewound: keep what was read for the serial re-run
+    w->trace_replay_buffer = wc.trace_replay_buffer;
+    w->trace_replay_buffer.insert(w->trace_replay_buffer.end(), w->spec_trace_reads.begin(), w->spec_trace_reads.end());
+    w->spec_trace_reads.clear();
+  }
+
+  c_spec_log.clear();
+  c_spec_n_cache_req = 0;
+  c_spec_n_l1_hits = 0;
+  c_spec_aborted = false;
+  c_l1cache->rollback_journal();
+}
+
+void core_c::commit_checkpoint() {
+  for (auto& wc : c_checkpoint.warps)
+    wc.warp->spec_trace_reads.clear();
+  c_checkpoint.warps.clear();
+  c_spec_log.clear();
+  c_l1cache->end_journal();
+
+  for (auto& pc : c_spec_simt_pc_stats) {
+    c_simt_pc_stats[pc.first].insts += pc.second.insts;
+    c_simt_pc_stats[pc.first].active_lanes += pc.second.active_lanes;
+  }
+  c_spec_simt_pc_stats.clear();
+}
+
+template <Warp_Scheduling_Policy_Types POLICY>
+bool core_c::schedule_warps(int sched) {
+  // Select warp scheduling policy (folded at compile time)
+  switch(POLICY) {
     case Warp_Scheduling_Policy_Types::ROUND_ROBIN:
-      return schedule_warps_rr();
+      return schedule_warps_rr(sched);
     case Warp_Scheduling_Policy_Types::GTO:
-      return schedule_warps_gto();
+      return schedule_warps_gto(sched);
     case Warp_Scheduling_Policy_Types::CCWS:
-      return schedule_warps_ccws();
+      return schedule_warps_ccws(sched);
     default:
       ASSERTM(0, "Warp Scheduling Policy not valid!");
       return true;
   }
 }
 
-bool core_c::schedule_warps_rr() { 
-  // If there are no available warps to run, skip the cycle
-  if (!c_dispatched_warps.empty()) {
-    c_running_warp = c_dispatched_warps.front();
-    c_dispatched_warps.erase(c_dispatched_warps.begin());
-    return false;
+bool core_c::schedule_warps_rr(int sched) { 
+  // Run the first warp that can issue; if there are no available warps to run, skip the cycle
+  for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)) {
+    if (can_issue(c_warp_slots.warp(slot))) {
+      c_running_warp = c_warp_slots.warp(slot);
+      c_warp_slots.pop_ready(slot);
+      return false;
+    }
   }
   return true;
 }
 
-bool core_c::schedule_warps_gto() {
+bool core_c::schedule_warps_gto(int sched) {
   // TODO: Implement the GTO logic here
   /*
     GTO logic goes here
   */  
 
-  static std::unordered_map<int, int> last_scheduled_warp; // mapping from core_id to warp_id
-
   // If no warps to schedule, return true to skip cycle
-  if (c_dispatched_warps.empty()) return true;
+  if (c_warp_slots.ready_empty(sched)) return true;
 
   // Use the last used warp
-  int last_warp_id = last_scheduled_warp[core_id];
-
-
-  auto it = std::find_if(c_dispatched_warps.begin(), c_dispatched_warps.end(),
-                         [last_warp_id](warp_s* w) { return last_warp_id == w->warp_id; });
-
-  if (it != c_dispatched_warps.end()) {
-    c_running_warp = *it;
-    c_dispatched_warps.erase(it);
-    last_scheduled_warp[core_id] = c_running_warp->warp_id;
-    return false;
+  int last_warp_id = c_gto_last_warp_id[sched];
+
+  for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)) {
+    if (c_warp_slots.warp(slot)->warp_id == last_warp_id && can_issue(c_warp_slots.warp(slot))) {
+      c_running_warp = c_warp_slots.warp(slot);
+      c_warp_slots.pop_ready(slot);
+      c_gto_last_warp_id[sched] = c_running_warp->warp_id;
+      return false;
+    }
   }
 
   // Else, find the oldest warp by timestamp
   warp_s* oldestWarp = nullptr;
   sim_time_type oldestTime = std::numeric_limits<sim_time_type>::max();
-  auto oldestIterator = c_dispatched_warps.begin();
-
-  for (auto it = c_dispatched_warps.begin(); it != c_dispatched_warps.end(); ++it) {
-    if ((*it)->timestampMarkerGTO < oldestTime) {
-      oldestTime = (*it)->timestampMarkerGTO;
-      oldestWarp = *it;
-      oldestIterator = it;
+  int oldestSlot = -1;
+
+  for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)) {
+    warp_s* w = c_warp_slots.warp(slot);
+    if (w->timestampMarkerGTO < oldestTime && can_issue(w)) {
+      oldestTime = w->timestampMarkerGTO;
+      oldestWarp = w;
+      oldestSlot = slot;
     }
   }
 
   if (oldestWarp) {
     c_running_warp = oldestWarp;
-    c_dispatched_warps.erase(oldestIterator);
-    last_scheduled_warp[core_id] = c_running_warp->warp_id;
+    c_warp_slots.pop_ready(oldestSlot);
+    c_gto_last_warp_id[sched] = c_running_warp->warp_id;
     return false;
   }
 
@@ -328,7 +1120,7 @@ bool core_c::schedule_warps_gto() {
 
 
 
-bool core_c::schedule_warps_ccws() {
+bool core_c::schedule_warps_ccws(int sched) {
   // TODO: Task 2.4: Implement the CCWS logic here
   /*
     CCWS logic goes here
@@ -339,19 +1131,23 @@ bool core_c::schedule_warps_ccws() {
 
   // TODO: Task 2-4a: determine cumulative LLS cutoff 
   int cumulative_lls_cutoff = 0; 
-  int num_active = c_dispatched_warps.size();
+  int num_active = c_warp_slots.num_ready(sched);
   if (num_active == 0) return true;
   
-  cumulative_lls_cutoff = get_running_warp_num() * CCWS_LLS_BASE_SCORE;
+  // Each scheduler throttles the warps of its own slots
+  cumulative_lls_cutoff = c_warp_slots.num_used(sched) * CCWS_LLS_BASE_SCORE;
 
-  if (!c_dispatched_warps.empty()) {
+  if (!c_warp_slots.ready_empty(sched)) {
     // TODO: Task 2.4b: Construct schedulable warps set:
     // - Create a copy of the dispatch queue, and sort it in descending order.
     // - Collect the the warps with highest LLS scores (until we reach the cumulative cutoff) to construct the 
     //   schedulable warps set.
 
     // Copy dispatch queue
-    std::vector<warp_s*> sorted_warps = c_dispatched_warps;
+    std::vector<warp_s*> sorted_warps;
+    sorted_warps.reserve(num_active);
+    for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot))
+      sorted_warps.push_back(c_warp_slots.warp(slot));
 
     // sort the vector by scores (descending order)
     std::sort(sorted_warps.begin(), sorted_warps.end(), [](warp_s* a, warp_s* b) {
@@ -389,10 +1185,12 @@ bool core_c::schedule_warps_ccws() {
     // TODO: Task 2.4c: Use Round Robin as baseline scheduling logic to schedule warps from the dispatch queue only if 
     // the warp is present in the scheduleable warps set
 
-    for (auto it = c_dispatched_warps.begin(); it != c_dispatched_warps.end(); ++it) {
-      if (std::find(scheduleableSetOfWarps.begin(), scheduleableSetOfWarps.end(), *it) != scheduleableSetOfWarps.end()) {
-        c_running_warp = *it;
-        c_dispatched_warps.erase(it);
+    for (int slot = c_warp_slots.first_ready(sched); slot != -1; slot = c_warp_slots.next_ready(slot)) {
+      warp_s* w = c_warp_slots.warp(slot);
+      if (std::find(scheduleableSetOfWarps.begin(), scheduleableSetOfWarps.end(), w) != scheduleableSetOfWarps.end() &&
+          can_issue(w)) {
+        c_running_warp = w;
+        c_warp_slots.pop_ready(slot);
         return false;
       }
     }
@@ -403,13 +1201,402 @@ bool core_c::schedule_warps_ccws() {
 }
 
 
-bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool enable_cache){
-  gpusim->inc_n_cache_req();
+void core_c::fetch(int sched) {
+  // Round robin over the warps of the scheduler with room in their instruction buffer
+  int n_sched_slots = (c_warp_slots.size() - sched + c_n_schedulers - 1) / c_n_schedulers;
+  warp_s* warp = NULL;
+  for (int i = 0; i < n_sched_slots && !warp; i++) {
+    int idx = (c_fetch_rr[sched] + i) % n_sched_slots;
+    int slot = sched + idx * c_n_schedulers;
+    if (c_warp_slots.state(slot) == Warp_Slot_State::FREE)
+      continue;
+    warp_s* w = c_warp_slots.warp(slot);
+    if (w->fetch_wait || w->ibuf_insts >= c_ibuf_size)
+      continue;
+    if (w->ibuf_insts >= (int)w->trace_buffer.size() && !refill_trace_buffer(w))
+      continue; // every instruction left is fetched
+    warp = w;
+    c_fetch_rr[sched] = (idx + 1) % n_sched_slots;
+  }
+  if (!warp)
+    return;
+  c_fetch_busy = true;
+
+  // Instructions are fetched in trace order
+  Addr inst_addr = warp->trace_buffer[warp->ibuf_insts]->m_inst_addr;
+  Addr line_addr = inst_addr & ~(Addr)(c_icache_line_size - 1);
+  Addr cache_line_addr, victim_line_addr;
+  c_icache_accesses++;
+  if (c_icache->access_cache(inst_addr, &cache_line_addr, true, 0)) {
+    fetch_line(warp, line_addr);
+    return;
+  }
+
+  // Miss: another warp may already wait for the line
+  c_icache_misses++;
+  for (icache_miss_s& miss : c_icache_misses_pending) {
+    if (miss.line_addr == line_addr) {
+      miss.slots.push_back(warp->slot_id);
+      warp->fetch_wait = true;
+      return;
+    }
+  }
+
+  // L2 hit: the line is inserted, and fetched right away
+  if (ENABLE_CACHE && access_l2(line_addr | INST_ADDR_BASE, false)) {
+    c_icache_l2_hits++;
+    c_icache->insert_cache(inst_addr, &cache_line_addr, &victim_line_addr, 0, false);
+    fetch_line(warp, line_addr);
+    return;
+  }
+  c_icache_misses_pending.push_back({line_addr, {warp->slot_id}});
+  warp->fetch_wait = true;
+  gpusim->ifetch_event(line_addr | INST_ADDR_BASE, c_icache_line_size, core_id, warp->warp_id, warp->slot_id);
+}
+
+void core_c::fetch_line(warp_s* warp, Addr line_addr) {
+  int n_fetched = 0;
+  while (n_fetched < c_fetch_width && warp->ibuf_insts < c_ibuf_size &&
+         warp->ibuf_insts < (int)warp->trace_buffer.size() &&
+         (warp->trace_buffer[warp->ibuf_insts]->m_inst_addr & ~(Addr)(c_icache_line_size - 1)) == line_addr) {
+    warp->ibuf_insts++;
+    n_fetched++;
+  }
+  c_fetched_insts += n_fetched;
+}
+
+void core_c::icache_fill(Addr line_addr) {
+  Addr cache_line_addr, victim_line_addr;
+  c_icache->insert_cache(line_addr, &cache_line_addr, &victim_line_addr, 0, false);
+
+  // The waiting warps take their instructions from the fill (a later fill may evict the line before
+  // their next turn)
+  for (auto it = c_icache_misses_pending.begin(); it != c_icache_misses_pending.end(); ++it) {
+    if (it->line_addr == line_addr) {
+      for (int slot : it->slots) {
+        warp_s* warp = c_warp_slots.warp(slot);
+        warp->fetch_wait = false;
+        fetch_line(warp, line_addr);
+      }
+      c_icache_misses_pending.erase(it);
+      return;
+    }
+  }
+}
+
+int core_c::free_collector_unit() {
+  for (int i = 0; i < (int)c_oc_free_cycle.size(); i++)
+    if (c_oc_free_cycle[i] <= c_cycle)
+      return i;
+  return -1;
+}
+
+int core_c::collect_operands(warp_s* warp, trace_info_nvbit_small_s* trace_info) {
+  // Distinct source registers (RZ, 255, reads no bank)
+  uint16_t regs[MAX_NVBIT_SRC_NUM];
+  int n_regs = 0;
+  for (int i = 0; i < trace_info->m_num_read_regs && i < MAX_NVBIT_SRC_NUM; i++) {
+    uint16_t reg = trace_info->m_src[i];
+    if (reg == 255 || std::find(regs, regs + n_regs, reg) != regs + n_regs)
+      continue;
+    regs[n_regs++] = reg;
+  }
+  if (n_regs == 0)
+    return 0;
+
+  // Registers of a warp are spread over the banks from a per warp offset. Each read takes the
+  // earliest free port of its bank, after the reads of the instructions collected before.
+  sim_time_type collected = c_cycle + 1;
+  for (int i = 0; i < n_regs; i++) {
+    std::vector<sim_time_type>& ports = c_rf_port_free_cycle[(regs[i] + warp->slot_id) % c_rf_banks];
+    auto port = std::min_element(ports.begin(), ports.end());
+    sim_time_type read_cycle = std::max(c_cycle, *port);
+    *port = read_cycle + 1;
+    collected = std::max(collected, read_cycle + 1);
+    c_rf_reads++;
+    if (read_cycle > c_cycle)
+      c_rf_conflict_reads++;
+  }
+
+  // The collector unit holds the instruction until its last operand is read
+  int unit = free_collector_unit();
+  assert(unit >= 0);
+  c_oc_free_cycle[unit] = collected;
+  int conflict_cycles = collected - (c_cycle + 1);
+  c_rf_conflict_cycles += conflict_cycles;
+  return conflict_cycles;
+}
+
+int core_c::free_func_unit(int fu) {
+  std::vector<sim_time_type>& free_cycle = c_fu_free_cycle[fu];
+  for (int i = 0; i < (int)free_cycle.size(); i++)
+    if (free_cycle[i] <= c_cycle)
+      return i;
+  return -1;
+}
+
+int core_c::shmem_wavefronts(trace_info_nvbit_small_s* trace_info) {
+  // Words of the banks accessed by the active threads, c_shmem_stride bytes apart (the trace only
+  // holds the address of the first active thread). Threads reading the same word share it.
+  c_shmem_words.clear();
+  Addr size = std::max<Addr>(trace_info->m_mem_access_size, 1);
+  Addr stride = c_shmem_stride ? c_shmem_stride : size;
+  for (int lane = 0; lane < 32; lane++) {
+    if (!(trace_info->m_active_mask & (1u << lane)))
+      continue;
+    Addr first = (trace_info->m_mem_addr + lane * stride) / c_shmem_bank_width;
+    Addr last = (trace_info->m_mem_addr + lane * stride + size - 1) / c_shmem_bank_width;
+    for (Addr word = first; word <= last; word++)
+      c_shmem_words.push_back(word);
+  }
+  std::sort(c_shmem_words.begin(), c_shmem_words.end());
+  c_shmem_words.erase(std::unique(c_shmem_words.begin(), c_shmem_words.end()), c_shmem_words.end());
+
+  // A bank serves one word per cycle
+  std::fill(c_shmem_bank_words.begin(), c_shmem_bank_words.end(), 0);
+  int wavefronts = 1;
+  for (Addr word : c_shmem_words)
+    wavefronts = std::max(wavefronts, ++c_shmem_bank_words[word % c_shmem_banks]);
+
+  // Conflicts: wavefronts beyond what the number of words needs at full bandwidth
+  int min_wavefronts = std::max<int>(1, (c_shmem_words.size() + c_shmem_banks - 1) / c_shmem_banks);
+  c_shmem_insts++;
+  c_shmem_wavefronts += wavefronts;
+  if (wavefronts > min_wavefronts) {
+    c_shmem_conflict_insts++;
+    c_shmem_conflict_cycles += wavefronts - min_wavefronts;
+  }
+  return wavefronts;
+}
+
+void core_c::coalesce(trace_info_nvbit_small_s* trace_info, Addr addr) {
+  // Threads of the warp access consecutive elements c_coalescer_stride bytes apart (the trace only
+  // holds the address of the first active thread)
+  c_coalesced_units.clear();
+  Addr size = std::max<Addr>(trace_info->m_mem_access_size, 1);
+  Addr stride = c_coalescer_stride ? c_coalescer_stride : size;
+  for (int lane = 0; lane < 32; lane++) {
+    if (!(trace_info->m_active_mask & (1u << lane)))
+      continue;
+    Addr first = (addr + lane * stride) / c_coalescer_unit_size;
+    Addr last = (addr + lane * stride + size - 1) / c_coalescer_unit_size;
+    for (Addr unit = first; unit <= last; unit++)
+      if (c_coalesced_units.empty() || c_coalesced_units.back() < unit * c_coalescer_unit_size)
+        c_coalesced_units.push_back(unit * c_coalescer_unit_size);
+  }
+}
+
+Addr core_c::mem_addr(warp_s* warp, trace_info_nvbit_small_s* trace_info) {
+  if (!c_local_mem || get_mem_space(trace_info) != Mem_Space_Types::LOCAL)
+    return trace_info->m_mem_addr;
+
+  // Every warp has its own local space, where the threads' words are interleaved (the same local
+  // address of the 32 threads is contiguous)
+  return LOCAL_ADDR_BASE + ((Addr)(uint32_t)warp->warp_id << 32) + (trace_info->m_mem_addr & 0x7ffffff) * 32;
+}
+
+bool core_c::access_const(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz) {
+  // The trace holds one address per warp: every thread reads it, a single broadcast access
+  c_const_accesses++;
+  Addr line_addr, repl_line_addr;
+  if (c_const_cache->access_cache(addr, &line_addr, true, 0)) {
+    c_const_hits++;
+    return false;
+  }
+
+  // Miss: L2, then memory (the response fills the constant cache)
+  if (ENABLE_CACHE && access_l2(addr, false)) {
+    c_const_l2_hits++;
+    c_const_cache->insert_cache(addr, &line_addr, &repl_line_addr, 0, false);
+    return false;
+  }
+  send_mem_event(trace_info, addr, access_sz, false, false, true);
+  return true;
+}
+
+void core_c::const_fill(Addr addr) {
+  Addr line_addr, repl_line_addr;
+  c_const_cache->insert_cache(addr, &line_addr, &repl_line_addr, 0, false);
+}
+
+bool core_c::access_l2_only(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz) {
+  bool is_write = is_st(trace_info->m_opcode);
+  if (access_l2(addr, is_write))
+    return false;
+  send_mem_event(trace_info, addr, access_sz, false, is_write);
+  return true;
+}
+
+int core_c::translate(trace_info_nvbit_small_s* trace_info) {
+  // Pages of the lines/sectors accessed by the active threads
+  Addr addr = mem_addr(c_running_warp, trace_info);
+  Addr page_mask = ~(Addr)(c_page_size - 1);
+  std::vector<Addr> pages;
+  if (c_coalescer_unit_size) {
+    coalesce(trace_info, addr);
+    for (Addr unit_addr : c_coalesced_units)
+      if (std::find(pages.begin(), pages.end(), unit_addr & page_mask) == pages.end())
+        pages.push_back(unit_addr & page_mask);
+  } else {
+    pages.push_back(addr & page_mask);
+  }
+
+  int misses = 0;
+  for (Addr page : pages) {
+    Addr line_addr;
+    c_tlb_accesses++;
+    if (c_l1_tlb->access_cache(page, &line_addr, true, 0))
+      continue;
+    c_tlb_misses++;
+    gpusim->tlb_miss(page, core_id, c_running_warp->slot_id);
+    misses++;
+  }
+  return misses;
+}
+
+void core_c::tlb_fill(Addr page) {
+  Addr line_addr, repl_line_addr;
+  c_l1_tlb->insert_cache(page, &line_addr, &repl_line_addr, 0, false);
+}
+
+void core_c::prefetch(trace_info_nvbit_small_s* trace_info) {
+  // The fill of a miss is not waited for: its request carries no warp slot
+  Addr addr = mem_addr(c_running_warp, trace_info);
+  Addr l1_line_addr = addr & ~(Addr)(l1cache_line_size - 1);
+  Addr line_addr, repl_line_addr;
+  bool to_l1 = trace_info->m_cache_level == (uint8_t)Cache_Level_Types::L1;
+  if (to_l1)
+    c_l1_prefetches++;
+  else
+    c_l2_prefetches++;
+
+  // Prefetches use the L1 TLB but don't walk the page table: one whose page misses is dropped
+  if (c_l1_tlb) {
+    Addr page = addr & ~(Addr)(c_page_size - 1);
+    if (!c_l1_tlb->access_cache(page, &line_addr, false, 0)) {
+      c_tlb_dropped_prefetches++;
+      return;
+    }
+    // Pages enter the L1 TLB once migrated, so prefetches never reach host memory
+    ASSERTM(!gpusim->m_gpu_params->Enable_UVM || gpusim->uvm_page_resident(page),
+            "Core %d prefetches page %llx, which is not in device memory\n", core_id, (unsigned long long)page);
+  }
+
+  // Lines already in the target cache, or on their way for an earlier miss (L1 MSHR entry), are not fetched again
+  if ((c_l1_mshr_entries && l1_mshr_find(l1_line_addr) >= 0) ||
+      (to_l1 && c_l1cache->access_cache(addr, &line_addr, false, 0))) {
+    c_redundant_prefetches++;
+    return;
+  }
+
+  // No warp lost the evicted line: it doesn't go to a VTA (as for prefetch misses, see repair_l1_miss)
+  if (access_l2(addr, false)) {
+    if (to_l1)
+      c_l1cache->insert_cache(addr, &line_addr, &repl_line_addr, 0, false);
+    else
+      c_redundant_prefetches++;
+    return;
+  }
+
+  // An L1 prefetch miss takes an L1 MSHR entry, as a demand miss does, so later misses on the line merge
+  // into it. Without a free entry the prefetch is dropped.
+  if (to_l1 && c_l1_mshr_entries) {
+    if ((int)c_l1_mshr.size() >= c_l1_mshr_entries) {
+      c_dropped_prefetches++;
+      return;
+    }
+    c_l1_mshr.push_back({l1_line_addr, {}});
+  }
+  gpusim->inst_event(trace_info, addr, trace_info->m_mem_access_size, core_id, c_running_warp->block_id,
+                     c_running_warp->warp_id, -1, c_cycle, to_l1, false);
+}
+
+int core_c::send_atomic_req(trace_info_nvbit_small_s* trace_info) {
+  // Thread operations per L2 line. With the coalescer, threads update consecutive elements (see
+  // coalesce()); otherwise they all update the traced address.
+  Addr line_size = gpusim->m_gpu_params->L2Cache_Line_Size;
+  Addr size = std::max<Addr>(trace_info->m_mem_access_size, 1);
+  Addr stride = !c_coalescer_unit_size ? 0 : c_coalescer_stride ? c_coalescer_stride : size;
+  c_atomic_lines.clear();
+  for (int lane = 0; lane < 32; lane++) {
+    if (!(trace_info->m_active_mask & (1u << lane)))
+      continue;
+    Addr line = (trace_info->m_mem_addr + lane * stride) & ~(line_size - 1);
+    if (c_atomic_lines.empty() || c_atomic_lines.back().first != line)
+      c_atomic_lines.push_back(make_pair(line, 0));
+    c_atomic_lines.back().second++;
+  }
+
+  // Bypass L1: its copy of the line is stale once the atomic unit updates it
+  c_atomic_insts++;
+  int dst_reg = trace_info->m_num_dest_regs > 0 ? trace_info->m_dst[0] : -1;
+  for (auto& line : c_atomic_lines) {
+    c_l1cache->invalidate_cache_line(line.first);
+    gpusim->atomic_event(line.first, trace_info->m_mem_access_size, line.second, core_id, c_running_warp->warp_id,
+                         c_running_warp->slot_id, dst_reg);
+  }
+  return c_atomic_lines.size();
+}
+
+template <bool CACHE, bool CACHE_LOG>
+int core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info){
+  Addr addr = trace_info->m_mem_addr;
+  if (c_const_cache || c_local_mem) {
+    Mem_Space_Types space = get_mem_space(trace_info);
+    if (c_const_cache && space == Mem_Space_Types::CONSTANT)
+      return access_const(trace_info, addr, trace_info->m_mem_access_size) ? 1 : 0;
+    if (c_local_mem && space == Mem_Space_Types::LOCAL) {
+      addr = mem_addr(c_running_warp, trace_info);
+      if (is_st(trace_info->m_opcode))
+        c_local_stores++;
+      else
+        c_local_loads++;
+    }
+  }
+  if (!c_coalescer_unit_size)
+    return access_mem<CACHE, CACHE_LOG>(trace_info, addr, trace_info->m_mem_access_size) ? 1 : 0;
+
+  // One access per distinct line (or sector) touched by the warp
+  coalesce(trace_info, addr);
+  c_coalescer_insts++;
+  c_coalescer_units += c_coalesced_units.size();
+  int n_requests = 0;
+  for (Addr unit_addr : c_coalesced_units)
+    if (access_mem<CACHE, CACHE_LOG>(trace_info, unit_addr, c_coalescer_unit_size))
+      n_requests++;
+  return n_requests;
+}
+
+template <bool CACHE, bool CACHE_LOG>
+bool core_c::access_mem(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz){
+  bool local = c_local_mem && get_mem_space(trace_info) == Mem_Space_Types::LOCAL;
+  if (CACHE && local && c_local_l1_policy == Local_Mem_L1_Policy_Types::BYPASS)
+    return access_l2_only(trace_info, addr, access_sz);
+
+  // Cache operators: .cg and .cv loads and .cg stores are served by L2 (a .cg store invalidates the
+  // L1 copy of the line)
+  Cache_Op_Types cache_op = Cache_Op_Types::NONE;
+  if (CACHE && c_cache_ops) {
+    cache_op = get_cache_op(trace_info);
+    c_cop_accesses[(int)cache_op]++;
+    bool is_store = is_st(trace_info->m_opcode);
+    if (cache_op == Cache_Op_Types::CG || (!is_store && cache_op == Cache_Op_Types::CV)) {
+      if (is_store)
+        c_l1cache->invalidate_cache_line(addr);
+      c_cop_l1_bypasses[(int)cache_op]++;
+      return access_l2_only(trace_info, addr, access_sz);
+    }
+  }
+
+  if (c_speculative)
+    c_spec_n_cache_req++;
+  else
+    gpusim->inc_n_cache_req();
 
   // Check if caches are enabled
-  if(!enable_cache) {
+  if(!CACHE) {
     // send request to memory directly
-    gpusim->inst_event(trace_info, core_id, c_running_warp->block_id, c_running_warp->warp_id, c_cycle);
+    send_mem_event(trace_info, addr, access_sz);
     return true; // suspend warp
   }
 
@@ -418,7 +1605,6 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
   // L1 cache: Write through - Write no allocate
   // L2 cache: Write back - write allocate.
 
-  Addr addr = trace_info->m_mem_addr;
   bool is_read = is_ld(trace_info->m_opcode);
   Addr line_addr;
   Addr repl_line_addr;
@@ -434,7 +1620,20 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
     if(l1_hit) {
       // *** L1 Read Hit ***
       // - Return val, continue warp
-      gpusim->inc_n_l1_hits();
+      if (c_speculative)
+        c_spec_n_l1_hits++;
+      else
+        gpusim->inc_n_l1_hits();
+      if (local)
+        c_local_l1_hits++;
+      if (c_cache_ops) {
+        // Last use: the line is not read again. Streaming: the line stays the next victim
+        c_cop_l1_hits[(int)cache_op]++;
+        if (cache_op == Cache_Op_Types::LU)
+          c_l1cache->invalidate_cache_line(addr);
+        else if (cache_op == Cache_Op_Types::CS)
+          c_l1cache->set_evict_first(addr);
+      }
       
       CACHELOG(printf("L1 Read: Hit\n");)
       return false; // continue warp
@@ -443,6 +1642,12 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
       // *** L1 Read Miss ***
       CACHELOG(printf("L1 Read: Miss\n");)
 
+      // Last use: no need to allocate the line
+      if (cache_op == Cache_Op_Types::LU) {
+        c_cop_l1_bypasses[(int)cache_op]++;
+        return access_l2_only(trace_info, addr, access_sz);
+      }
+
       //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
       // TODO: Task 2.2a: Upon L1 Read miss, we need to check if the tag corresponding to the address is present in 
       // currently executing warp's VTA.
@@ -457,6 +1662,8 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
       bool vta_hit = false;
 
       vta_hit = c_running_warp->ccws_vta_entry->access(vta_ln_tag);
+      if (c_policy == Warp_Scheduling_Policy_Types::CCWS)
+        c_vta_lookups++;
 
       if(vta_hit) { // VTA Hit
         // Increment VTA hits counter
@@ -475,9 +1682,20 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
       }
       //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+      // Another warp already missed on the line: wait for its response (no L2 access)
+      Addr l1_line_addr = addr & ~(Addr)(l1cache_line_size - 1);
+      if (c_l1_mshr_entries) {
+        int idx = l1_mshr_find(l1_line_addr);
+        if (idx >= 0) {
+          int dst_reg = trace_info->m_is_load && trace_info->m_num_dest_regs > 0 ? trace_info->m_dst[0] : -1;
+          c_l1_mshr[idx].waiters.push_back({c_running_warp->slot_id, dst_reg, addr, false});
+          c_l1_mshr_merges++;
+          return true; // suspend warp
+        }
+      }
+
       // Access L2
-      cache_data_t * l2_access_data = (cache_data_t*) c_l2cache->access_cache(addr, &line_addr, true, 0);
-      bool l2_hit = l2_access_data ? true : false;
+      bool l2_hit = access_l2(addr, false);
 
       if(l2_hit){
         // *** L2 Read Hit ***
@@ -487,6 +1705,8 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
         
         // Insert in L1
         cache_data_t* l1_ins_ln = (cache_data_t*)c_l1cache->insert_cache(addr, &line_addr, &repl_line_addr, 0, false);
+        if (cache_op == Cache_Op_Types::CS)
+          c_l1cache->set_evict_first(addr);
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         // TODO: Task 2.1a: Insert the tag in warp's VTA entry upon L1 eviction.
@@ -516,7 +1736,9 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
         // - Suspend warp
 
         CACHELOG(printf("L2 Read: Miss, Memory request sent.. (Warp Suspended)\n");)
-        gpusim->inst_event(trace_info, core_id, c_running_warp->block_id, c_running_warp->warp_id, c_cycle, true, false);
+        if (c_l1_mshr_entries)
+          c_l1_mshr.push_back({l1_line_addr, {}});
+        send_mem_event(trace_info, addr, access_sz, true, false);
         
         return true; // suspend warp
       }
@@ -535,7 +1757,17 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
       // *** L1 Write Hit ***
       // - Update value in L1: already updated LRU timestamp
       // - Write through to L2
-      gpusim->inc_n_l1_hits();
+      if (c_speculative)
+        c_spec_n_l1_hits++;
+      else
+        gpusim->inc_n_l1_hits();
+      if (local)
+        c_local_l1_hits++;
+      if (c_cache_ops) {
+        c_cop_l1_hits[(int)cache_op]++;
+        if (cache_op == Cache_Op_Types::CS)
+          c_l1cache->set_evict_first(addr);
+      }
       CACHELOG(printf("L1 Write: Hit, Write val in L1\n");)
     }
     else {
@@ -557,6 +1789,8 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
       bool vta_hit = false;
 
       vta_hit = c_running_warp->ccws_vta_entry->access(vta_ln_tag);
+      if (c_policy == Warp_Scheduling_Policy_Types::CCWS)
+        c_vta_lookups++;
 
       if(vta_hit) { // VTA Hit
         // Increment VTA hits counter
@@ -574,19 +1808,28 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
         c_running_warp->ccws_lls_score = llds;
       }
       //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // Spilled registers are read back soon: local stores allocate the line
+      if (local && c_local_l1_policy == Local_Mem_L1_Policy_Types::WRITE_ALLOCATE) {
+        c_l1cache->insert_cache(addr, &line_addr, &repl_line_addr, 0, false);
+        if (repl_line_addr) {
+          Addr repl_ln_tag;
+          int dummy_set;
+          c_l1cache->find_tag_and_set(repl_line_addr, &repl_ln_tag, &dummy_set);
+          c_running_warp->ccws_vta_entry->insert(repl_ln_tag);
+        }
+      }
     }
 
     // Write through irrespective of L1 Hit/Miss
     CACHELOG(printf("Writing through to L2\n");)
 
-    cache_data_t * l2_access_data = (cache_data_t*) c_l2cache->access_cache(addr, &line_addr, true, 0);
-    bool l2_hit = l2_access_data ? true : false;
+    bool l2_hit = access_l2(addr, true);
     if(l2_hit) {
       // *** L2 Write Hit ***
-      // - Mark dirty
+      // - Mark dirty (done by access_l2)
       // - Continue Warp
       CACHELOG(printf("L2 Write: Hit, Marking dirty\n");)
-      l2_access_data->m_dirty = true;
       return false; // continue
     }
     else {
@@ -598,7 +1841,7 @@ bool core_c::send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool en
 
       // L2 Miss: Get a block from memory, delegate mark dirty
       CACHELOG(printf("L2 Write: Miss, Memory request sent.. (Warp Suspended)\n");)
-      gpusim->inst_event(trace_info, core_id, c_running_warp->block_id, c_running_warp->warp_id, c_cycle, false, true);
+      send_mem_event(trace_info, addr, access_sz, false, true);
 
       // Need to mark the block dirty after miss repair -> handled in macsim::get_mem_response()
       return true; // suspend warp
@@ -2,10 +2,13 @@
 #define CORE_H
 
 #include <queue>
+#include <unordered_map>
 #include <vector>
 #include "trace.h"
 #include "macsim.h"
 #include "cache.h"
+#include "optimistic.h"
+#include "warp_slots.h"
 
 class macsim;
 class cache_c;
@@ -18,13 +21,11 @@ public:
   int c_fetching_block_id = -1;
 
   // Memory responses recieved
-  std::queue<int> c_memory_responses;
+  std::queue<core_mem_response_s> c_memory_responses;
 
-  // Active warp pool
-  std::vector<warp_s*> c_dispatched_warps;
-
-  // Suspended warps pool: warps waiting for response from memory
-  std::unordered_map<int, warp_s*> c_suspended_warps;
+  // Warps on the core: ready (dispatched) list and warps waiting for response from memory.
+  // Memory responses carry slot ids.
+  warp_slots_c c_warp_slots;
 
   //////////////////////////////////////////////////////////////////////////////
   
@@ -56,11 +57,25 @@ public:
   int get_max_running_warp_num();
 
   // Run one cycle
-  void run_a_cycle();
+  void run_a_cycle() { (this->*c_run_a_cycle)(); }
+
+  // Insert a line returned from memory in L1 (and the evicted tag in the requesting warp's VTA;
+  // slot_id -1 for a prefetch). A streaming (.cs) line is inserted as the next victim of its set.
+  void repair_l1_miss(Addr addr, int slot_id, bool evict_first=false);
+
+  // Insert a line returned from memory in the constant cache
+  void const_fill(Addr addr);
+
+  // Insert a translated page in the L1 TLB
+  void tlb_fill(Addr page);
+
+  // Is a warp of the block waiting for memory (or at a barrier)?
+  bool has_suspended_warp_of_block(int block_id);
 
 
 private:
   friend class macsim;
+  friend class optimistic_c;
 
   int core_id = -1;             // Core ID
   macsim* gpusim;               // Pointer to Macsim instance
@@ -77,28 +92,292 @@ private:
   uint64_t num_vta_hits=0;                // Counter to keep track of VTA hits
 
   bool c_retire = false;                  // Has the core retired?
+  bool c_has_work = true;                 // False while every warp waits on memory (cycles are only counted)
+  sim_time_type c_idle_cycles = 0;        // Cycles skipped while idle (LLS decay is applied on wake up)
   sim_time_type c_cycle = 0;              // Number of cycles elapsed
   sim_time_type stall_cycles = 0;         // Counts number of stalled cycles
   uint64_t inst_count_total = 0;          // Total number of instructions executed by core 
-  const int c_max_running_warp_num = 4;   // Maximum number of warps that can run on a core.
+  uint64_t c_dep_stalls = 0;              // Scheduler cycles where every ready warp waited on a register
+  const int* c_opcode_latency = NULL;     // Result latency per opcode (NULL: no register scoreboard)
+  bool c_non_blocking_loads = false;      // Warps keep issuing past L2 misses until a pending register is used
+  uint64_t c_load_use_stalls = 0;         // Warps suspended on the first use of a pending load register
+  int c_coalescer_unit_size = 0;          // Coalescer access granularity, line or sector (0: no coalescer)
+  int c_coalescer_stride = 0;             // Bytes between the addresses of consecutive threads (0: access size)
+  uint64_t c_coalescer_insts = 0;         // Memory instructions split by the coalescer
+  uint64_t c_coalescer_units = 0;         // Line/sector accesses they generated
+  std::vector<Addr> c_coalesced_units;    // Units touched by the current memory instruction
+  int c_l1_mshr_entries = 0;              // L1 MSHR entries (0: no MSHR)
+  int c_l1_mshr_merge_slots = 0;          // Requests that can merge into an L1 MSHR entry
+  uint64_t c_l1_mshr_merges = 0;          // L1 misses merged into an L1 MSHR entry
+  uint64_t c_mshr_stalls = 0;             // Scheduler cycles where every ready warp waited for an L1 MSHR
+  bool c_mshr_blocked = false;            // can_issue() refused a warp for lack of L1 MSHR entries
+
+  // L1 MSHR entry: a line missing in L1 and the requests waiting for it besides the primary one
+  struct l1_mshr_entry_s {
+    Addr line_addr;
+    std::vector<core_mem_response_s> waiters;
+  };
+  std::vector<l1_mshr_entry_s> c_l1_mshr;
+  bool c_barriers = false;                // Warps wait at BAR for the other warps of their block
+  uint64_t c_barriers_released = 0;       // Barriers all expected warps arrived at
+  uint64_t c_barrier_waits = 0;           // Warps that waited at a barrier
+  uint64_t c_barrier_wait_cycles = 0;     // Cycles warps spent waiting at barriers
+  int c_shmem_banks = 0;                  // Shared memory banks (0: no bank conflict model)
+  int c_shmem_bank_width = 0;             // Bytes per bank and cycle
+  int c_shmem_stride = 0;                 // Bytes between the addresses of consecutive threads (0: access size)
+  sim_time_type c_ldst_free_cycle = 0;    // The LD/ST pipe replays a shared memory access until this cycle
+  bool c_ldst_blocked = false;            // can_issue() refused a warp because the LD/ST pipe was busy
+  uint64_t c_ldst_stalls = 0;             // Scheduler cycles where every ready warp waited for the LD/ST pipe
+  uint64_t c_shmem_insts = 0;             // Shared memory instructions
+  uint64_t c_shmem_conflict_insts = 0;    // Shared memory instructions with bank conflicts
+  uint64_t c_shmem_wavefronts = 0;        // Cycles the shared memory banks were accessed
+  uint64_t c_shmem_conflict_cycles = 0;   // Wavefronts replayed because of bank conflicts
+  std::vector<Addr> c_shmem_words;        // Bank words touched by the current shared memory instruction
+  std::vector<int> c_shmem_bank_words;    // Of those, words per bank
+  bool c_func_units = false;              // Instructions wait for a free functional unit of their type
+  std::vector<std::vector<sim_time_type>> c_fu_free_cycle;  // Per unit type and instance: cycle it accepts the next instruction
+  int c_fu_ii[NUM_FUNC_UNIT_TYPES];       // Initiation interval per unit type
+  int c_fu_blocked = -1;                  // Unit type can_issue() found busy (-1: none)
+  uint64_t c_fu_issued[NUM_FUNC_UNIT_TYPES] = {};  // Instructions issued per unit type
+  uint64_t c_fu_stalls[NUM_FUNC_UNIT_TYPES] = {};  // Scheduler cycles where every ready warp waited for the unit type
+  cache_c* c_icache = NULL;               // Instruction cache (NULL: fetch is free)
+  int c_icache_line_size = 0;
+  int c_fetch_width = 0;                  // Instructions a scheduler fetches per cycle, from one line
+  int c_ibuf_size = 0;                    // Instruction buffer entries per warp
+  std::vector<int> c_fetch_rr;            // Per scheduler: warp slot (index among its slots) to fetch for next
+  bool c_fetch_blocked = false;           // can_issue() refused a warp with an empty instruction buffer
+  bool c_fetch_busy = false;              // A warp fetched this cycle
+  uint64_t c_icache_accesses = 0;         // Instruction cache lookups
+  uint64_t c_icache_misses = 0;           // Of those, misses
+  uint64_t c_icache_l2_hits = 0;          // Misses served by L2
+  uint64_t c_fetched_insts = 0;           // Instructions moved into instruction buffers
+  uint64_t c_fetch_stalls = 0;            // Scheduler cycles where every ready warp had an empty instruction buffer
 
-  // Pointer to currently running warp
+  // Instruction line missing in the instruction cache and the warps waiting for it
+  struct icache_miss_s {
+    Addr line_addr;
+    std::vector<int> slots;
+  };
+  std::vector<icache_miss_s> c_icache_misses_pending;
+  int c_rf_banks = 0;                     // Register file banks behind the operand collector (0: no operand collector)
+  std::vector<std::vector<sim_time_type>> c_rf_port_free_cycle;  // Per bank and read port: cycle it reads the next register
+  std::vector<sim_time_type> c_oc_free_cycle;  // Per collector unit: cycle its operands are collected
+  bool c_oc_blocked = false;              // can_issue() found every collector unit busy
+  uint64_t c_rf_reads = 0;                // Source registers read
+  uint64_t c_rf_conflict_reads = 0;       // Of those, reads delayed by a busy bank
+  uint64_t c_rf_conflict_cycles = 0;      // Cycles instructions waited for their operands beyond one
+  uint64_t c_oc_stalls = 0;               // Scheduler cycles where every ready warp waited for a collector unit
+  cache_c* c_const_cache = NULL;          // Constant cache for LDC (NULL: constant loads use L1)
+  uint64_t c_const_accesses = 0;          // Constant cache accesses
+  uint64_t c_const_hits = 0;              // Of those, hits
+  uint64_t c_const_l2_hits = 0;           // Misses served by L2
+  bool c_local_mem = false;               // Local memory (LDL/STL) has its own address space per warp
+  Local_Mem_L1_Policy_Types c_local_l1_policy = Local_Mem_L1_Policy_Types::GLOBAL;
+  uint64_t c_local_loads = 0;             // Local memory load and store accesses (a blocking load executes
+  uint64_t c_local_stores = 0;            // again after its miss, as for CACHE_NUM_ACCESSES)
+  uint64_t c_local_l1_hits = 0;           // Their L1 hits
+  bool c_cache_ops = false;               // Honor the cache operators of loads and stores, and prefetches
+  uint64_t c_cop_accesses[NUM_CACHE_OP_TYPES] = {};     // Cache accesses per cache operator
+  uint64_t c_cop_l1_hits[NUM_CACHE_OP_TYPES] = {};      // Their L1 hits
+  uint64_t c_cop_l1_bypasses[NUM_CACHE_OP_TYPES] = {};  // Accesses sent to L2 without allocating in L1
+  uint64_t c_l1_prefetches = 0;           // Prefetches to L1 and to L2
+  uint64_t c_l2_prefetches = 0;
+  uint64_t c_redundant_prefetches = 0;    // Of those, lines already in the target cache (or in the L1 MSHR)
+  uint64_t c_dropped_prefetches = 0;      // L1 prefetch misses dropped for a full L1 MSHR
+  uint64_t c_tlb_dropped_prefetches = 0;  // Prefetches dropped for an L1 TLB miss
+  cache_c* c_l1_tlb = NULL;               // L1 TLB (NULL: no address translation)
+  int c_page_size = 0;
+  uint64_t c_tlb_accesses = 0;            // L1 TLB lookups
+  uint64_t c_tlb_misses = 0;              // Of those, misses
+  bool c_l2_atomics = false;              // Global atomics go to the L2 atomic unit (bypassing L1)
+  uint64_t c_atomic_insts = 0;            // Atomic warp instructions sent to the L2
+  std::vector<std::pair<Addr, int>> c_atomic_lines;  // L2 lines of the current atomic and their thread operations
+  bool c_simt_stats = false;              // Track active threads (SIMT efficiency) and branch divergence
+  uint64_t c_simt_insts = 0;              // Warp instructions committed
+  uint64_t c_simt_active_lanes = 0;       // Their active threads
+  uint64_t c_branches = 0;                // Conditional branches
+  uint64_t c_divergent_branches = 0;      // Branches taken by part of the active threads only
+  uint64_t c_simt_warps = 0;              // Finished warps
+  double c_min_warp_simt_eff = 1.0;       // Lowest and highest SIMT efficiency of a finished warp
+  double c_max_warp_simt_eff = 0.0;
+  double c_sum_warp_simt_eff = 0.0;       // Summed over finished warps
+  uint64_t c_warp_simt_eff[SIMT_EFF_BUCKETS] = {};  // Finished warps per SIMT efficiency range
+  bool c_energy_model = false;            // Count the events of the energy model
+  uint64_t c_energy_insts[NUM_FUNC_UNIT_TYPES + 1] = {};  // Instructions committed per unit type (last: no unit)
+  uint64_t c_vta_lookups = 0;             // VTA lookups (CCWS only, the other policies ignore their hits)
+  std::unordered_map<uint64_t, simt_pc_stats_s> c_simt_pc_stats;       // By instruction address
+  std::unordered_map<uint64_t, simt_pc_stats_s> c_spec_simt_pc_stats;  // Not committed yet (speculative)
+  int c_max_running_block_num;            // Maximum number of blocks that can run on a core
+  int c_max_running_warp_num;             // Maximum number of warps that can run on a core (warp slots)
+  int c_n_schedulers;                     // Number of warp schedulers, each owns slot % c_n_schedulers
+  Warp_Scheduling_Policy_Types c_policy;  // Warp scheduling policy of the core
+
+  // Warp running on each scheduler (back to the dispatch queue next cycle)
+  std::vector<warp_s*> c_sched_running_warps;
+
+  // Pointer to the warp being issued by the current scheduler
   warp_s* c_running_warp = NULL;
 
-  // Warp scheduler
-  bool schedule_warps(Warp_Scheduling_Policy_Types policy);
+  // Last warp scheduled by GTO, per scheduler
+  std::vector<int> c_gto_last_warp_id;
+
+  // Optimistic (speculative) execution, driven by optimistic_c
+  bool c_speculative = false;             // Running ahead of the committed cycle?
+  bool c_spec_aborted = false;            // Speculation reached an irrevocable action
+  sim_time_type c_spec_cycle = 0;         // GPU cycle being speculated
+  sim_time_type c_cache_clock = 0;        // L1 replacement clock while speculating
+  uint64_t c_spec_n_cache_req = 0;        // Cache requests not yet committed to macsim
+  uint64_t c_spec_n_l1_hits = 0;          // L1 hits not yet committed to macsim
+  vector<spec_event_s> c_spec_log;        // Shared-state accesses to validate and replay at commit
+  core_checkpoint_s c_checkpoint;         // Core state at the start of the speculative window
+
+  // Save core state at the start of a speculative window
+  void save_checkpoint();
+
+  // Restore core state saved by save_checkpoint()
+  void restore_checkpoint();
+
+  // Keep speculative state, drop the checkpoint
+  void commit_checkpoint();
+
+  // Refill trace buffer of a warp, returns false if the trace has ended
+  bool refill_trace_buffer(warp_s* warp);
+
+  // Can the warp issue its next instruction (source and destination registers not pending)?
+  bool can_issue(warp_s* warp);
+
+  // L1 MSHR entry of a line (-1: none)
+  int l1_mshr_find(Addr line_addr);
+
+  // Can the L1 MSHR take every line the global load of the instruction may miss?
+  bool l1_mshr_can_accept(warp_s* warp, trace_info_nvbit_small_s* trace_info);
+
+  // Fetch stage of scheduler sched: fill the instruction buffer of one of its warps from the instruction cache
+  void fetch(int sched);
+
+  // Move up to c_fetch_width instructions of the line from the warp's trace into its instruction buffer
+  void fetch_line(warp_s* warp, Addr line_addr);
+
+  // An instruction cache miss returned: insert the line and fetch it for the warps waiting for it
+  void icache_fill(Addr line_addr);
+
+  // Free collector unit this cycle (-1: all busy)
+  int free_collector_unit();
+
+  // Operand collector: read the source registers of the instruction from their banks in a collector
+  // unit, returns the cycles bank conflicts add to the one cycle operand read
+  int collect_operands(warp_s* warp, trace_info_nvbit_small_s* trace_info);
+
+  // Free instance of a functional unit type this cycle (-1: all busy)
+  int free_func_unit(int fu);
+
+  // SIMT statistics of an instruction the warp committed
+  void simt_account(warp_s* warp, trace_info_nvbit_small_s* trace_info);
+
+  // The running warp committed a BAR: wait for the other warps of its block (or release them if
+  // it arrived last), returns true
+  bool arrive_at_barrier(int sched, int barrier_id, int n_threads);
+
+  // Have all the warps a barrier waits for arrived?
+  bool barrier_complete(block_schedule_info_s* block, const block_barrier_s& barrier);
+
+  // Wake up the warps of the block waiting at the barrier
+  void release_barrier(int block_id, int barrier_id);
+
+  // A memory response for the warp in slot slot_id (dst_reg: load it answers)
+  void deliver_response(int slot_id, int dst_reg);
+
+  // Mark the destination registers of an issued instruction pending for its latency (plus extra_cycles)
+  void scoreboard_issue(warp_s* warp, trace_info_nvbit_small_s* trace_info, int extra_cycles=0);
+
+  // Shared memory: cycles (wavefronts) the banks take to serve the instruction, one per distinct word
+  // of the most conflicted bank
+  int shmem_wavefronts(trace_info_nvbit_small_s* trace_info);
+
+  // Non-blocking loads: does the warp's next instruction use a register of a load in flight (or is
+  // the warp at the end of its trace with requests in flight, or waiting for a translation)?
+  bool waits_on_load(warp_s* warp);
+
+  // Non-blocking loads: a request of the warp returned, dst_reg identifies the load (-1: none)
+  void complete_mem_request(warp_s* warp, int dst_reg);
+
+  // Access L2 (write hits mark the line dirty), returns true on hit
+  bool access_l2(Addr addr, bool is_write);
+
+  // Generate a memory request for the running warp
+  void send_mem_event(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz,
+                      bool on_response_insert_in_l1=false, bool on_response_mark_dirty=false,
+                      bool on_response_insert_in_const=false);
+
+  // Address of the first active thread of a memory instruction of the warp: local memory addresses
+  // are moved to the warp's local space (Enable_Local_Mem_Space)
+  Addr mem_addr(warp_s* warp, trace_info_nvbit_small_s* trace_info);
+
+  // Constant load through the constant cache (one broadcast access per warp), returns true if a
+  // memory request was sent
+  bool access_const(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz);
+
+  // Access served by L2 without allocating in L1 (Local_Mem_L1_Policy BYPASS, .cg/.cv/.lu), returns
+  // true if a memory request was sent
+  bool access_l2_only(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz);
+
+  // Look up the pages touched by the memory instruction of the running warp in the L1 TLB, returns
+  // the number of misses (sent to the L2 TLB)
+  int translate(trace_info_nvbit_small_s* trace_info);
+
+  // Prefetch (CCTL) of the running warp to L1 or L2: it does not wait for the line
+  void prefetch(trace_info_nvbit_small_s* trace_info);
+
+  // Send the atomic of the running warp to the L2 atomic unit, one request per line touched by the
+  // active threads; returns the number of requests
+  int send_atomic_req(trace_info_nvbit_small_s* trace_info);
+
+  // Coalescer: fill c_coalesced_units with the lines/sectors touched by the active threads
+  void coalesce(trace_info_nvbit_small_s* trace_info, Addr addr);
+
+  // run_a_cycle() specialized per warp scheduling policy and cache mode, picked once by the
+  // constructor (policies are listed in CORE_PIPELINE_POLICIES, core.cpp)
+  typedef void (core_c::*run_a_cycle_fn)();
+  run_a_cycle_fn c_run_a_cycle;
+
+  template <Warp_Scheduling_Policy_Types POLICY, bool CACHE, bool CACHE_LOG>
+  void run_a_cycle_impl();
+
+  // Pick the run_a_cycle() specialization
+  static run_a_cycle_fn select_run_a_cycle(Warp_Scheduling_Policy_Types policy, bool enable_cache,
+                                           bool enable_cache_log);
+
+  template <Warp_Scheduling_Policy_Types POLICY, bool CACHE_LOG>
+  static run_a_cycle_fn select_cache_mode(bool enable_cache);
+
+  // Schedule a warp on scheduler sched and execute one instruction, returns false if no warp was ready
+  template <Warp_Scheduling_Policy_Types POLICY, bool CACHE, bool CACHE_LOG>
+  bool issue_warp(int sched);
+
+  // The running warp committed an instruction: keep it on scheduler sched (or suspend it), returns true
+  bool issue_done(int sched);
+
+  // Warp scheduler (picks c_running_warp from the ready warps of scheduler sched)
+  template <Warp_Scheduling_Policy_Types POLICY>
+  bool schedule_warps(int sched);
 
   // Round Robin (RR) warp scheduler
-  bool schedule_warps_rr();
+  bool schedule_warps_rr(int sched);
 
   // Greedy Then Oldest (GTO) warp scheduler
-  bool schedule_warps_gto();
+  bool schedule_warps_gto(int sched);
 
   // Greedy Then Oldest (CCWS) warp scheduler
-  bool schedule_warps_ccws();
+  bool schedule_warps_ccws(int sched);
+
+  // Send a memory request (CACHE: caches enabled, CACHE_LOG: log cache accesses)
+  template <bool CACHE, bool CACHE_LOG>
+  // Returns the number of memory requests sent (the warp waits for their responses)
+  int send_mem_req(int wid, trace_info_nvbit_small_s* trace_info);
 
-  // Send a memory request
-  bool send_mem_req(int wid, trace_info_nvbit_small_s* trace_info, bool enable_cache);
+  // Access one address of a memory instruction through L1/L2, returns true if a memory request was sent
+  template <bool CACHE, bool CACHE_LOG>
+  bool access_mem(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz);
 };
 
 #endif
\ No newline at end of file
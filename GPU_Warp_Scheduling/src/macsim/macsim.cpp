@@ -35,6 +35,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <cstdlib>
 #include <random>
+#include <algorithm>
 
 #include "trace.h"
 #include "macsim.h"
@@ -43,6 +44,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "ram.h"
 #include "ccws_vta.h"
+#include "optimistic.h"
 
 using namespace std;
 
@@ -92,9 +94,47 @@ macsim::macsim(GPU_Parameter_Set* gpu_params){
     c_insts_total[id] = 0;
     c_stall_cycles[id] = 0;
   }
+  init_core_configs();
+  ASSERTM(!m_gpu_params->Enable_Func_Units ||
+          (m_gpu_params->FU_SP_Units >= 1 && m_gpu_params->FU_DP_Units >= 1 && m_gpu_params->FU_SFU_Units >= 1 &&
+           m_gpu_params->FU_LDST_Units >= 1 && m_gpu_params->FU_Tensor_Units >= 1),
+          "Functional unit counts (FU_*_Units) must be at least 1\n");
+  ASSERTM(!m_gpu_params->Shared_Mem_Bank_Model ||
+          (m_gpu_params->Shared_Mem_Banks >= 1 && m_gpu_params->Shared_Mem_Bank_Width >= 1),
+          "Shared_Mem_Banks and Shared_Mem_Bank_Width must be at least 1\n");
+  ASSERTM(!m_gpu_params->Enable_TLB || m_gpu_params->Page_Size == 4096 || m_gpu_params->Page_Size == 65536 ||
+          m_gpu_params->Page_Size == 2097152, "Page_Size must be 4096, 65536 or 2097152\n");
+  ASSERTM(!m_gpu_params->Enable_TLB || (m_gpu_params->Page_Walkers >= 1 && m_gpu_params->Page_Walk_Levels >= 1),
+          "Page_Walkers and Page_Walk_Levels must be at least 1\n");
+  ASSERTM(!m_gpu_params->Enable_UVM || m_gpu_params->Enable_TLB, "Enable_UVM needs Enable_TLB\n");
+  ASSERTM(!m_gpu_params->Enable_UVM || (m_gpu_params->UVM_Fault_Batch_Size >= 1 && m_gpu_params->UVM_Link_Bandwidth >= 1),
+          "UVM_Fault_Batch_Size and UVM_Link_Bandwidth must be at least 1\n");
+  ASSERTM(!m_gpu_params->Enable_Clock_Domains || (m_gpu_params->Core_Clock_MHz >= 1 && m_gpu_params->L2_Clock_MHz >= 1 &&
+          m_gpu_params->DRAM_Clock_MHz >= 1), "Core_Clock_MHz, L2_Clock_MHz and DRAM_Clock_MHz must be at least 1\n");
+  ASSERTM(!m_gpu_params->Enable_Energy_Model || m_gpu_params->Core_Clock_MHz >= 1,
+          "Core_Clock_MHz must be at least 1 (average power)\n");
+  if (m_gpu_params->Core_Clock_MHz >= 1)
+    m_core_clock = clock_domain_c(m_gpu_params->Core_Clock_MHz, m_gpu_params->Core_Clock_MHz);
+  if (m_gpu_params->Enable_Clock_Domains) {
+    m_l2_clock = clock_domain_c(m_gpu_params->L2_Clock_MHz, m_gpu_params->Core_Clock_MHz);
+    m_dram_clock = clock_domain_c(m_gpu_params->DRAM_Clock_MHz, m_gpu_params->Core_Clock_MHz);
+  }
+  for (int core_id = 0; core_id < n_of_cores; core_id++)
+    m_gto_last_warp_id.push_back(vector<int>(m_core_configs[core_id].n_schedulers, 0));
+
+  if (m_gpu_params->Exec_Latency_Model)
+    init_opcode_latency();
 
   cout << "Block Scheduling Policy: " << Block_Scheduling_Policy_Types_str[(int)block_scheduling_policy] << endl;
   cout << "Warp Scheduling Policy: " << Warp_Scheduling_Policy_Types_str[(int)warp_scheduling_policy] << endl;
+  if (!m_gpu_params->Core_Overrides.empty()) {
+    for (int core_id = 0; core_id < n_of_cores; core_id++) {
+      const core_config_s& cfg = m_core_configs[core_id];
+      printf("Core %d: %s, L1 %d sets x %d ways, %d warp slots, %d schedulers\n", core_id,
+             Warp_Scheduling_Policy_Types_str[(int)cfg.policy], cfg.l1cache_size, cfg.l1cache_assoc, cfg.max_warps,
+             cfg.n_schedulers);
+    }
+  }
 
   // Setup trace
   trace_reader_setup();
@@ -102,6 +142,150 @@ macsim::macsim(GPU_Parameter_Set* gpu_params){
 
 macsim::~macsim(){}
 
+int macsim::occupancy_blocks(const kernel_info_s& kernel, Occupancy_Limiter_Types* limiter) {
+  auto round_up = [](int n, int unit) { return unit > 1 ? (n + unit - 1) / unit * unit : n; };
+  int threads = kernel.threads_per_block >= 0 ? kernel.threads_per_block : kernel.n_warp_per_block * 32;
+  int regs = kernel.regs_per_thread >= 0 ? kernel.regs_per_thread : m_gpu_params->Default_Regs_Per_Thread;
+  int shmem = kernel.shared_mem_per_block >= 0 ? kernel.shared_mem_per_block : m_gpu_params->Default_Shared_Mem_Per_Block;
+  int warps = (threads + 31) / 32;
+
+  int blocks = m_gpu_params->Core_Max_Blocks;
+  *limiter = Occupancy_Limiter_Types::BLOCKS;
+  auto limit = [&](int n, Occupancy_Limiter_Types resource) {
+    if (n < blocks) {
+      blocks = n;
+      *limiter = resource;
+    }
+  };
+
+  // Warp slots, registers (allocated per warp) and shared memory (allocated per block)
+  limit(m_gpu_params->Core_Max_Threads / 32 / warps, Occupancy_Limiter_Types::WARPS);
+  if (regs > 0)
+    limit(m_gpu_params->Core_Registers / round_up(regs * 32, m_gpu_params->Reg_Alloc_Unit) / warps,
+          Occupancy_Limiter_Types::REGISTERS);
+  if (shmem > 0)
+    limit(m_gpu_params->Core_Shared_Mem / round_up(shmem, m_gpu_params->Shared_Mem_Alloc_Unit),
+          Occupancy_Limiter_Types::SHARED_MEM);
+
+  ASSERTM(blocks >= 1, "A block of the kernel (%d threads, %d registers per thread, %d bytes of shared memory) "
+          "does not fit on a core\n", threads, regs, shmem);
+  return blocks;
+}
+
+void macsim::init_opcode_latency()
+{
+  int unit_latency[] = {
+    m_gpu_params->Latency_INT,
+    m_gpu_params->Latency_IMAD,
+    m_gpu_params->Latency_FP32,
+    m_gpu_params->Latency_FP16,
+    m_gpu_params->Latency_FP64,
+    m_gpu_params->Latency_SFU,
+    m_gpu_params->Latency_Tensor,
+    m_gpu_params->Latency_Conv,
+    m_gpu_params->Latency_Shared_Mem,
+    m_gpu_params->Latency_Load_Hit,
+    m_gpu_params->Latency_Misc
+  };
+  int fu_depth[] = {
+    m_gpu_params->FU_SP_Depth,
+    m_gpu_params->FU_DP_Depth,
+    m_gpu_params->FU_SFU_Depth,
+    m_gpu_params->FU_LDST_Depth,
+    m_gpu_params->FU_Tensor_Depth
+  };
+  int n_opcodes = sizeof(GPU_NVBIT_OPCODE) / sizeof(GPU_NVBIT_OPCODE[0]);
+  m_opcode_latency.resize(n_opcodes);
+  for (int opcode = 0; opcode < n_opcodes; opcode++) {
+    m_opcode_latency[opcode] = unit_latency[(int)get_exec_unit(opcode)];
+
+    // Functional unit pipeline depth, if set, is the latency of its instructions
+    Func_Unit_Types fu = get_func_unit(get_exec_unit(opcode));
+    if (m_gpu_params->Enable_Func_Units && fu != Func_Unit_Types::NONE && fu_depth[(int)fu] > 0)
+      m_opcode_latency[opcode] = fu_depth[(int)fu];
+  }
+
+  // Constant loads hitting the constant cache
+  if (m_gpu_params->Enable_Const_Cache)
+    m_opcode_latency[LDC] = m_gpu_params->Const_Cache_Latency;
+
+  // Per-opcode overrides: "OPCODE:cycles,OPCODE:cycles,..."
+  stringstream overrides(m_gpu_params->Opcode_Latency);
+  string item;
+  while (getline(overrides, item, ',')) {
+    if (item.empty()) continue;
+    size_t sep = item.find(':');
+    if (sep == string::npos)
+      ASSERTM(0, "Opcode_Latency: expected OPCODE:cycles, got %s\n", item.c_str());
+    string name = item.substr(0, sep);
+    auto it = find(begin(GPU_NVBIT_OPCODE), end(GPU_NVBIT_OPCODE), name);
+    if (it == end(GPU_NVBIT_OPCODE))
+      ASSERTM(0, "Opcode_Latency: unknown opcode %s\n", name.c_str());
+    m_opcode_latency[it - begin(GPU_NVBIT_OPCODE)] = stoi(item.substr(sep + 1));
+  }
+
+  for (int latency : m_opcode_latency)
+    ASSERTM(latency >= 1, "Execution latencies must be at least 1 cycle\n");
+}
+
+void macsim::init_core_configs() {
+  core_config_s base = {m_gpu_params->L1Cache_Size, m_gpu_params->L1Cache_Assoc, m_gpu_params->Max_Warp_Per_Core,
+                        m_gpu_params->Warp_Schedulers_Per_Core, m_gpu_params->Warp_Scheduling_Policy};
+  m_core_configs.assign(n_of_cores, base);
+
+  // Overrides: "CORES:Param=value,Param=value;CORES:...", CORES is a core id or a cluster of cores "first-last"
+  stringstream groups(m_gpu_params->Core_Overrides);
+  string group;
+  while (getline(groups, group, ';')) {
+    if (group.empty()) continue;
+    size_t sep = group.find(':');
+    if (sep == string::npos)
+      ASSERTM(0, "Core_Overrides: expected CORES:Param=value,..., got %s\n", group.c_str());
+    string cores = group.substr(0, sep);
+    size_t dash = cores.find('-');
+    int first = stoi(cores.substr(0, dash));
+    int last = dash == string::npos ? first : stoi(cores.substr(dash + 1));
+    ASSERTM(first >= 0 && first <= last && last < n_of_cores, "Core_Overrides: invalid cores %s\n", cores.c_str());
+
+    stringstream settings(group.substr(sep + 1));
+    string item;
+    while (getline(settings, item, ',')) {
+      if (item.empty()) continue;
+      size_t eq = item.find('=');
+      if (eq == string::npos)
+        ASSERTM(0, "Core_Overrides: expected Param=value, got %s\n", item.c_str());
+      string name = item.substr(0, eq);
+      string val = item.substr(eq + 1);
+      for (int core_id = first; core_id <= last; core_id++) {
+        core_config_s& cfg = m_core_configs[core_id];
+        if (name == "L1Cache_Size") {
+          cfg.l1cache_size = stoi(val);
+        } else if (name == "L1Cache_Assoc") {
+          cfg.l1cache_assoc = stoi(val);
+        } else if (name == "Max_Warp_Per_Core") {
+          cfg.max_warps = stoi(val);
+        } else if (name == "Warp_Schedulers_Per_Core") {
+          cfg.n_schedulers = stoi(val);
+        } else if (name == "Warp_Scheduling_Policy") {
+          transform(val.begin(), val.end(), val.begin(), ::toupper);
+          auto it = find(begin(Warp_Scheduling_Policy_Types_str), end(Warp_Scheduling_Policy_Types_str), val);
+          if (it == end(Warp_Scheduling_Policy_Types_str))
+            ASSERTM(0, "Core_Overrides: unknown warp scheduling policy %s\n", val.c_str());
+          cfg.policy = (Warp_Scheduling_Policy_Types)(it - begin(Warp_Scheduling_Policy_Types_str));
+        } else {
+          ASSERTM(0, "Core_Overrides: %s can't be set per core\n", name.c_str());
+        }
+      }
+    }
+  }
+
+  for (const core_config_s& cfg : m_core_configs) {
+    ASSERTM(cfg.max_warps >= 1, "Max_Warp_Per_Core must be at least 1\n");
+    ASSERTM(cfg.n_schedulers >= 1 && cfg.n_schedulers <= cfg.max_warps,
+            "Warp_Schedulers_Per_Core must be between 1 and Max_Warp_Per_Core\n");
+    ASSERTM(cfg.l1cache_size >= 1 && cfg.l1cache_assoc >= 1, "L1Cache_Size and L1Cache_Assoc must be at least 1\n");
+  }
+}
 
 void macsim::trace_reader_setup()
 {
@@ -256,6 +440,30 @@ void macsim::trace_reader_setup()
     }
     kernel_info.n_of_block = warp_count / kernel_info.n_warp_per_block;
 
+    // open trace_resources.txt for every kernel, if present
+    // -------------------------------------------
+    // (kernel_name)/trace_resources.txt Format
+    // --------------------------------------------
+    // regs_per_thread       | # of registers of a thread
+    // shared_mem_per_block  | # of bytes of shared memory of a block
+    // threads_per_block     | # of threads of a block
+    string kernel_resources_path = kernel_path.substr(0, kernel_path.find_last_of('.'));
+    kernel_resources_path += "_resources.txt";
+
+    ifstream trace_resources_file(kernel_resources_path.c_str(), ifstream::in);
+    string resource;
+    int amount;
+    while (trace_resources_file >> resource >> amount) {
+      if (resource == "regs_per_thread")
+        kernel_info.regs_per_thread = amount;
+      else if (resource == "shared_mem_per_block")
+        kernel_info.shared_mem_per_block = amount;
+      else if (resource == "threads_per_block")
+        kernel_info.threads_per_block = amount;
+      else
+        ASSERTM(0, "unknown resource %s in file:%s\n", resource.c_str(), kernel_resources_path.c_str());
+    }
+
     kernel_info_v.push_back(kernel_info);
     trace_config_file.close();
     trace_info_file.close();
@@ -266,8 +474,9 @@ void macsim::trace_reader_setup()
   kernel_config_file.close();
 }
 
-void macsim::inst_event(trace_info_nvbit_small_s* trace_info, int core_id, 
-                        int block_id, int warp_id, sim_time_type c_cycle, bool on_response_insert_in_l1, bool on_response_mark_dirty) {
+void macsim::inst_event(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz, int core_id, 
+                        int block_id, int warp_id, int slot_id, sim_time_type c_cycle, bool on_response_insert_in_l1, bool on_response_mark_dirty,
+                        bool on_response_insert_in_const) {
   // Increment counters in core
   if (is_ld(trace_info->m_opcode))
     core_pointers_v[core_id]->ld_req_cnt++;
@@ -276,35 +485,315 @@ void macsim::inst_event(trace_info_nvbit_small_s* trace_info, int core_id,
 
   // add request to scoreboard
   GPU_scoreboard_entry sb_entry;
-  sb_entry.addr = trace_info->m_mem_addr;
+  sb_entry.addr = addr;
   sb_entry.PC = trace_info->m_inst_addr;
   sb_entry.req_time = m_cycle;
   sb_entry.is_mem = true;
   sb_entry.core_id = core_id;
   sb_entry.warp_id = warp_id;
+  sb_entry.slot_id = slot_id;
+  if (trace_info->m_is_load && trace_info->m_num_dest_regs > 0)
+    sb_entry.dst_reg = trace_info->m_dst[0];
   sb_entry.mem_queue_id = n_requests;
   sb_entry.insert_in_l1 = on_response_insert_in_l1;
   sb_entry.mark_dirty = on_response_mark_dirty;
+  sb_entry.insert_in_const = on_response_insert_in_const;
+  sb_entry.evict_first = m_gpu_params->Enable_Cache_Operators && get_cache_op(trace_info) == Cache_Op_Types::CS;
   GPU_scoreboard.push_back(sb_entry);
 
   // Generate memory request
   RAM_request ram_req = {
-    .addr = trace_info->m_mem_addr,
+    .addr = addr,
     .is_store = !trace_info->m_is_load,
-    .access_sz = trace_info->m_mem_access_size,
+    .access_sz = access_sz,
     .req_time = m_cycle,
     .core_id = core_id,
     .warp_id = warp_id,
+    .slot_id = slot_id,
     .request_id = n_requests
   };
-  gpu_mem_request_queue->push(ram_req);
+  send_mem_request(ram_req);
   
   n_requests++;
 }
 
+void macsim::ifetch_event(Addr line_addr, int line_size, int core_id, int warp_id, int slot_id) {
+  // add request to scoreboard
+  GPU_scoreboard_entry sb_entry;
+  sb_entry.addr = line_addr;
+  sb_entry.PC = line_addr & ~INST_ADDR_BASE;
+  sb_entry.req_time = m_cycle;
+  sb_entry.is_mem = true;
+  sb_entry.core_id = core_id;
+  sb_entry.warp_id = warp_id;
+  sb_entry.slot_id = slot_id;
+  sb_entry.mem_queue_id = n_requests;
+  sb_entry.ifetch = true;
+  GPU_scoreboard.push_back(sb_entry);
+
+  // Generate memory request
+  RAM_request ram_req = {
+    .addr = line_addr,
+    .is_store = false,
+    .access_sz = line_size,
+    .req_time = m_cycle,
+    .core_id = core_id,
+    .warp_id = warp_id,
+    .slot_id = slot_id,
+    .request_id = n_requests
+  };
+  send_mem_request(ram_req);
+
+  n_requests++;
+}
+
+void macsim::tlb_miss(Addr page, int core_id, int slot_id) {
+  tlb_response_s resp = {core_id, slot_id, page, m_cycle};
+
+  // The page is already being translated (or waits for its fault): wait for it
+  auto walk = m_tlb_walks.find(page);
+  if (walk != m_tlb_walks.end()) {
+    m_kernel_tlb_stats.merged_misses++;
+    if (walk->second == UVM_FAULT_PENDING)
+      m_uvm_waiters[page].push_back(resp);
+    else
+      m_tlb_responses.insert(make_pair(walk->second, resp));
+    return;
+  }
+
+  m_kernel_tlb_stats.l2_accesses++;
+  sim_time_type done = m_cycle + m_l2_clock.core_cycles(m_gpu_params->L2_TLB_Latency);
+  Addr line_addr, repl_line_addr;
+  if (!l2_tlb->access_cache(page, &line_addr, true, 0)) {
+    m_kernel_tlb_stats.l2_misses++;
+    done = page_walk(page, done);
+    l2_tlb->insert_cache(page, &line_addr, &repl_line_addr, 0, false);
+
+    // Unified memory: the walk finds a page in host memory (fault), or one still migrating (local
+    // memory is allocated in device memory)
+    if (m_gpu_params->Enable_UVM && !(page & LOCAL_ADDR_BASE)) {
+      auto uvm_page = m_uvm_pages.find(page);
+      if (uvm_page == m_uvm_pages.end()) {
+        n_uvm_faults++;
+        m_uvm_faults.insert(make_pair(done, page));
+        m_uvm_waiters[page].push_back(resp);
+        m_tlb_walks[page] = UVM_FAULT_PENDING;
+        return;
+      }
+      done = std::max(done, uvm_page->second);
+    }
+  }
+  m_tlb_walks[page] = done;
+  m_tlb_responses.insert(make_pair(done, resp));
+}
+
+sim_time_type macsim::page_walk(Addr page, sim_time_type start) {
+  // The first free walker takes the walk
+  auto walker = std::min_element(m_walker_free_cycle.begin(), m_walker_free_cycle.end());
+  sim_time_type begin = std::max(start, *walker);
+  m_kernel_tlb_stats.walk_queue_cycles += begin - start;
+
+  // Levels 0 to m_page_walk_levels-2 point to the next level table (9 bits of the page number each)
+  // and are cached in the page walk cache; the walk reads the levels below the deepest cached one
+  int page_bits = log2_int(m_gpu_params->Page_Size);
+  int mem_reads = m_page_walk_levels;
+  for (int level = m_page_walk_levels - 2; level >= 0; level--) {
+    Addr entry = ((Addr)(level + 1) << 56) | ((page >> (page_bits + 9 * (m_page_walk_levels - 1 - level))) << 3);
+    Addr line_addr, repl_line_addr;
+    if (m_page_walk_cache->access_cache(entry, &line_addr, true, 0)) {
+      mem_reads = m_page_walk_levels - 1 - level;
+      break;
+    }
+    m_page_walk_cache->insert_cache(entry, &line_addr, &repl_line_addr, 0, false);
+  }
+  m_kernel_tlb_stats.walk_mem_reads += mem_reads;
+
+  *walker = begin + m_l2_clock.core_cycles(m_gpu_params->Page_Walk_Cache_Latency) +
+            (sim_time_type)mem_reads * m_dram_clock.core_cycles(m_gpu_params->Page_Walk_Mem_Latency);
+  return *walker;
+}
+
+bool macsim::uvm_page_resident(Addr page) const {
+  if (page & LOCAL_ADDR_BASE)
+    return true;
+  auto uvm_page = m_uvm_pages.find(page);
+  return uvm_page != m_uvm_pages.end() && uvm_page->second <= m_cycle;
+}
+
+void macsim::uvm_service_faults() {
+  if (m_cycle < m_uvm_handler_free || m_uvm_faults.empty() || m_uvm_faults.begin()->first > m_cycle)
+    return;
+
+  // The faults raised so far form the batch, up to UVM_Fault_Batch_Size pages
+  vector<Addr> batch;
+  while (!m_uvm_faults.empty() && m_uvm_faults.begin()->first <= m_cycle &&
+         (int)batch.size() < m_gpu_params->UVM_Fault_Batch_Size) {
+    batch.push_back(m_uvm_faults.begin()->second);
+    m_uvm_faults.erase(m_uvm_faults.begin());
+  }
+
+  // Prefetch on fault: the whole UVM_Prefetch_Size block of a faulting page migrates with it
+  Addr page_size = m_gpu_params->Page_Size;
+  Addr block_size = std::max<Addr>(m_gpu_params->UVM_Prefetch_Size, page_size);
+  vector<Addr> migrated;
+  for (Addr page : batch) {
+    Addr block = page & ~(block_size - 1);
+    for (Addr p = block; p < block + block_size; p += page_size) {
+      if (m_uvm_pages.count(p))
+        continue;
+      m_uvm_pages[p] = 0;
+      migrated.push_back(p);
+      if (p != page)
+        n_uvm_prefetched_pages++;
+    }
+  }
+
+  // The driver handles the batch, then the pages cross the link
+  sim_time_type done = m_cycle + m_gpu_params->UVM_Fault_Latency + m_gpu_params->UVM_Link_Latency +
+                       (migrated.size() * page_size + m_gpu_params->UVM_Link_Bandwidth - 1) / m_gpu_params->UVM_Link_Bandwidth;
+  for (Addr p : migrated)
+    m_uvm_pages[p] = done;
+  n_uvm_batches++;
+  n_uvm_migrated_pages += migrated.size();
+  n_uvm_batch_cycles += done - m_cycle;
+  m_uvm_handler_free = done;
+
+  // Translations of the faulting pages return once their page is in device memory (a page
+  // prefetched by an earlier batch may be already)
+  for (Addr page : batch) {
+    sim_time_type ready = std::max(m_uvm_pages[page], m_cycle);
+    m_tlb_walks[page] = ready;
+    for (const tlb_response_s& resp : m_uvm_waiters[page])
+      m_tlb_responses.insert(make_pair(ready, resp));
+    m_uvm_waiters.erase(page);
+  }
+}
+
+void macsim::atomic_event(Addr addr, int access_sz, int n_ops, int core_id, int warp_id, int slot_id, int dst_reg) {
+  n_atomic_requests++;
+  n_atomic_ops += n_ops;
+  GPU_scoreboard_entry sb_entry;
+  sb_entry.addr = addr;
+  sb_entry.PC = 0;
+  sb_entry.req_time = m_cycle;
+  sb_entry.is_mem = true;
+  sb_entry.core_id = core_id;
+  sb_entry.warp_id = warp_id;
+  sb_entry.slot_id = slot_id;
+  sb_entry.dst_reg = dst_reg;
+  sb_entry.atomic_ops = n_ops;
+
+  // The atomic unit updates the line in L2
+  Addr line_addr;
+  cache_data_t* l2_line = NULL;
+  if (m_gpu_params->Enable_GPU_Cache) {
+    l2_line = (cache_data_t*)l2cache->access_cache(addr, &line_addr, true, 0);
+    count_l2_access(l2_line != NULL);
+  }
+  if (l2_line) {
+    l2_line->m_dirty = true;
+    atomic_unit_enqueue(sb_entry);
+    return;
+  }
+
+  // L2 miss: fetch the line (it is dirty once updated), see respond()
+  n_atomic_l2_misses++;
+  sb_entry.mem_queue_id = n_requests;
+  sb_entry.mark_dirty = true;
+  GPU_scoreboard.push_back(sb_entry);
+  RAM_request ram_req = {
+    .addr = addr,
+    .is_store = false,
+    .access_sz = access_sz,
+    .req_time = m_cycle,
+    .core_id = core_id,
+    .warp_id = warp_id,
+    .slot_id = slot_id,
+    .request_id = n_requests
+  };
+  send_mem_request(ram_req);
+  n_requests++;
+}
+
+void macsim::atomic_unit_enqueue(const GPU_scoreboard_entry& entry) {
+  // Operations on a line are serialized, Atomic_Op_Cycles each
+  Addr line = entry.addr & ~(Addr)(l2cache_line_size - 1);
+  sim_time_type& free_cycle = m_atomic_line_free[line];
+  sim_time_type start = std::max(m_cycle, free_cycle);
+  free_cycle = start + m_l2_clock.core_cycles((sim_time_type)entry.atomic_ops * m_gpu_params->Atomic_Op_Cycles);
+  m_atomic_responses.insert(make_pair(free_cycle + m_l2_clock.core_cycles(m_gpu_params->Atomic_Latency), entry));
+
+  atomic_line_stats_s& stats = m_atomic_line_stats[line];
+  stats.requests++;
+  stats.ops += entry.atomic_ops;
+  stats.wait_cycles += start - m_cycle;
+  if (start > m_cycle)
+    n_atomic_contended++;
+  n_atomic_wait_cycles += start - m_cycle;
+}
+
+void macsim::send_mem_request(const RAM_request& ram_req) {
+  if (!m_gpu_params->Enable_MSHR)
+    push_ram_request(ram_req);
+  else if (!m_l2_mshr_queue.empty() || !l2_mshr_send(ram_req)) {
+    // Wait for a free L2 MSHR entry, behind the misses already waiting
+    n_l2_mshr_waits++;
+    m_l2_mshr_queue.push_back(ram_req);
+  }
+}
+
+bool macsim::l2_mshr_send(const RAM_request& ram_req) {
+  Addr line = ram_req.addr & ~(Addr)(l2cache_line_size - 1);
+  auto entry = m_l2_mshr.find(line);
+  if (entry != m_l2_mshr.end()) {
+    // Secondary miss: answered with the primary response
+    if ((int)entry->second.merged_ids.size() >= m_gpu_params->L2_MSHR_Merge_Slots)
+      return false;
+    entry->second.merged_ids.push_back(ram_req.request_id);
+    n_l2_mshr_merges++;
+    return true;
+  }
+  if ((int)m_l2_mshr.size() >= m_gpu_params->L2_MSHR_Entries)
+    return false;
+
+  // Primary miss
+  m_l2_mshr[line].request_id = ram_req.request_id;
+  push_ram_request(ram_req);
+  return true;
+}
+
+void macsim::l2_mshr_retry() {
+  while (!m_l2_mshr_queue.empty()) {
+    RAM_request ram_req = m_l2_mshr_queue.front();
+    ram_req.req_time = m_cycle;
+    if (!l2_mshr_send(ram_req))
+      break;
+    m_l2_mshr_queue.pop_front();
+  }
+}
+
+void macsim::respond(const GPU_scoreboard_entry& entry) {
+  // The line of an atomic is in L2: the atomic unit answers
+  if (entry.atomic_ops > 0) {
+    atomic_unit_enqueue(entry);
+    return;
+  }
+
+  // Delegated insert in L1
+  if(entry.insert_in_l1)
+    core_pointers_v[entry.core_id]->repair_l1_miss(entry.addr, entry.slot_id, entry.evict_first);
+  if (entry.insert_in_const)
+    core_pointers_v[entry.core_id]->const_fill(entry.addr);
+
+  // Finally insert response in core responses queue
+  core_pointers_v[entry.core_id]->c_memory_responses.push({entry.slot_id, entry.dst_reg, entry.addr, entry.insert_in_l1,
+                                                            entry.ifetch});
+}
+
 void macsim::get_mem_response() {
-  // check mem response and update entries
-  while (gpu_mem_response_queue->size() != 0) {
+  // check mem response and update entries (responses produced by RAM ahead of this cycle stay queued)
+  while (gpu_mem_response_queue->size() != 0 &&
+         m_dram_clock.core_cycle_of(gpu_mem_response_queue->front().resp_time) < m_cycle) {
 
     // Pop one response from the response queue
     auto response = gpu_mem_response_queue->front();
@@ -320,64 +809,39 @@ void macsim::get_mem_response() {
       if (entry->mem_queue_id == mem_response_id) {
         req_time = entry->req_time; //entry.req_time + delay;
         resp_time = m_cycle - req_time;
+        GPU_scoreboard_entry primary = *entry;
+        GPU_scoreboard.erase(entry);
 
-        // Delegated insert in L2 cache
-        Addr line_addr, victim_line_addr;
-        cache_data_t* l2_ins_ln = (cache_data_t*) l2cache->insert_cache(entry->addr, &line_addr, &victim_line_addr, 0, false);
-
-        // writeback replaced line if it was valid and dirty
-        if(victim_line_addr && l2_ins_ln->m_dirty) {
-          // Generate memory request for writeback
-          RAM_request ram_req = {
-            .addr = victim_line_addr,
-            .is_store = true,
-            .access_sz = l2cache_line_size,
-            .req_time = m_cycle,
-            .core_id = -1,
-            .warp_id = -1,
-            .request_id = n_requests
-          };
-          n_requests++;
-          gpu_mem_request_queue->push(ram_req);
+        // L2 MSHR: the requests merged into the primary miss share its response
+        vector<GPU_scoreboard_entry> merged;
+        bool mark_dirty = primary.mark_dirty;
+        if (m_gpu_params->Enable_MSHR) {
+          auto mshr = m_l2_mshr.find(primary.addr & ~(Addr)(l2cache_line_size - 1));
+          if (mshr != m_l2_mshr.end() && mshr->second.request_id == mem_response_id) {
+            for (uint64_t id : mshr->second.merged_ids) {
+              auto sec = find_if(GPU_scoreboard.begin(), GPU_scoreboard.end(),
+                                 [id](const GPU_scoreboard_entry& e) { return e.mem_queue_id == id; });
+              if (sec == GPU_scoreboard.end())
+                continue; // timed out
+              merged.push_back(*sec);
+              mark_dirty |= sec->mark_dirty;
+              GPU_scoreboard.erase(sec);
+            }
+            m_l2_mshr.erase(mshr);
+          }
         }
 
-        // Delegated mark dirty in l2
-        l2_ins_ln->m_dirty = entry->mark_dirty;
-
-        // Delegated insert in L1
-        if(entry->insert_in_l1) {
-          // Insert in L1
-          core_pointers_v[entry->core_id]->c_l1cache->insert_cache(entry->addr, &line_addr, &victim_line_addr, 0, false);
-
-          //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-          // TODO: Task 2.1b: Insert the tag in warp's VTA entry upon L1 eviction.
-          // Steps:
-          //  - Get tag corresponding to the address. (see if any of the cache class methods can help with this)
-          //  - Search for the warp that issued the request in core's (entry->core_id) suspended queue and Insert 
-          //    the tag in warp's VTA entry
-          if(victim_line_addr) {
-            // Get the tag from the address
-            Addr repl_ln_tag;
-            int dummy_set;
-            core_c* core__ = core_pointers_v[entry->core_id];
-            core__->c_l1cache->find_tag_and_set(victim_line_addr, &repl_ln_tag, &dummy_set);
-            warp_s* warp = core__->c_suspended_warps[entry->warp_id];
-            warp->ccws_vta_entry->insert(repl_ln_tag); 
-
-            // Get the warp pointer from suspended queue of core (use core_id from entry->core_id)
-
-            // Insert the tag into the warp's VTA
-            CCWSLOG(printf("VTA insertion: %llx\n", repl_ln_tag));
+        // Delegated insert in L2 cache (and mark dirty), writeback replaced line if it was valid and dirty
+        Addr victim_line_addr;
+        if (fill_l2(primary.addr, mark_dirty, &victim_line_addr))
+          send_writeback(victim_line_addr);
 
-          }
-          //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        respond(primary);
+        for (const GPU_scoreboard_entry& sec : merged) {
+          respond(sec);
+          n_responses++;
+          total_latency += m_cycle - sec.req_time;
         }
-
-        // Finally insert response in core responses queue
-        core_pointers_v[response.core_id]->c_memory_responses.push(response.warp_id);
-        
-        // erase scoreboard entry
-        GPU_scoreboard.erase(entry);
         break;
       }
     }
@@ -387,6 +851,67 @@ void macsim::get_mem_response() {
       MA_DEBUG2("RAM resp id:" << response.request_id << " m_cycle=" << m_cycle << " req_time=" 
       << req_time << " resp_time=" << resp_time << " total_latency=" << total_latency);
   }
+
+  // Entries freed by the responses go to the misses waiting for them
+  if (!m_l2_mshr_queue.empty())
+    l2_mshr_retry();
+
+  // Atomics done by the L2 atomic unit
+  while (!m_atomic_responses.empty() && m_atomic_responses.begin()->first <= m_cycle) {
+    const GPU_scoreboard_entry& entry = m_atomic_responses.begin()->second;
+    core_pointers_v[entry.core_id]->c_memory_responses.push({entry.slot_id, entry.dst_reg, entry.addr, false, false});
+    n_atomic_latency += m_cycle - entry.req_time;
+    auto line = m_atomic_line_free.find(entry.addr & ~(Addr)(l2cache_line_size - 1));
+    if (line != m_atomic_line_free.end() && line->second <= m_cycle)
+      m_atomic_line_free.erase(line);
+    m_atomic_responses.erase(m_atomic_responses.begin());
+  }
+
+  // Translations of the L2 TLB and the page walkers
+  if (m_gpu_params->Enable_UVM)
+    uvm_service_faults();
+  while (!m_tlb_responses.empty() && m_tlb_responses.begin()->first <= m_cycle) {
+    const tlb_response_s& resp = m_tlb_responses.begin()->second;
+    m_kernel_tlb_stats.miss_latency += m_cycle - resp.req_time;
+    core_pointers_v[resp.core_id]->c_memory_responses.push({resp.slot_id, -1, resp.page, false, false, true});
+    auto walk = m_tlb_walks.find(resp.page);
+    if (walk != m_tlb_walks.end() && walk->second <= m_cycle)
+      m_tlb_walks.erase(walk);
+    m_tlb_responses.erase(m_tlb_responses.begin());
+  }
+}
+
+bool macsim::fill_l2(Addr addr, bool mark_dirty, Addr* victim_addr) {
+  Addr line_addr;
+  cache_data_t* l2_ins_ln = (cache_data_t*) l2cache->insert_cache(addr, &line_addr, victim_addr, 0, false);
+
+  // The replaced line keeps its data block, so its dirty bit is still visible here
+  bool writeback = *victim_addr && l2_ins_ln->m_dirty;
+
+  // Delegated mark dirty in l2
+  l2_ins_ln->m_dirty = mark_dirty;
+  return writeback;
+}
+
+void macsim::send_writeback(Addr line_addr) {
+  // Generate memory request for writeback
+  RAM_request ram_req = {
+    .addr = line_addr,
+    .is_store = true,
+    .access_sz = l2cache_line_size,
+    .req_time = m_cycle,
+    .core_id = -1,
+    .warp_id = -1,
+    .slot_id = -1,
+    .request_id = n_requests
+  };
+  n_requests++;
+  push_ram_request(ram_req);
+}
+
+void macsim::push_ram_request(RAM_request ram_req) {
+  ram_req.req_time = m_dram_clock.cycles_at(ram_req.req_time);
+  gpu_mem_request_queue->push(ram_req);
 }
 
 bool macsim::run_a_cycle(){
@@ -395,17 +920,24 @@ bool macsim::run_a_cycle(){
 
   if (kernel_starting) start_kernel();
 
-  // Run cores
-  for (int core_id = 0; core_id < n_of_cores; core_id++) {
-    core_c* core = core_pointers_v[core_id];
-    if (core->is_retired()) continue;
-
+  // Run cores (retired cores are dropped from the active list)
+  bool core_retired = false;
+  for (core_c* core : m_active_cores) {
     core->run_a_cycle();
+    if (core->is_retired()) {
+      m_n_retired_cores++;
+      core_retired = true;
+    }
   }
+  if (core_retired)
+    m_active_cores.erase(remove_if(m_active_cores.begin(), m_active_cores.end(),
+                                   [](core_c* core) { return core->is_retired(); }),
+                         m_active_cores.end());
 
   // Check whether there is a response in latency tracker queue. If so, 
-  // send the reply to the cores
-  get_mem_response();
+  // send the reply to the cores (on the clock edges of L2)
+  if (m_l2_clock.ticks_at(m_cycle))
+    get_mem_response();
 
   // Timeout resolution: check MEM request queue at interval=t, if outstanding 
   // time > 10*average latency, report timeout request (print at end)
@@ -420,7 +952,8 @@ bool macsim::run_a_cycle(){
           << entry->req_time << " wait_time=" << wait_time<< " avg_latency=" << get_avg_latency() << "ns");
 
         // respond to cores
-        core_pointers_v[entry->core_id]->c_memory_responses.push(entry->warp_id);
+        core_pointers_v[entry->core_id]->c_memory_responses.push({entry->slot_id, entry->dst_reg, entry->addr,
+                                                                   entry->insert_in_l1, entry->ifetch});
         GPU_scoreboard.erase(entry);
       } else {
         entry++;
@@ -443,17 +976,35 @@ bool macsim::run_a_cycle(){
 
 void macsim::start_kernel(){
   cout << "========== starting kernel " << kernel_id << " ==========" << endl;
+  m_kernel_start_cycle = m_cycle;
+
+  // Blocks per core from the resources of the kernel (each core clamps them to its warp slots)
+  if (m_gpu_params->Enable_Occupancy_Model)
+    max_block_per_core = occupancy_blocks(kernel_info_v[kernel_id], &m_occupancy_limiter);
 
   // Setup L2 Cache (the size will be the twice of the l1 cache's total size)
   l2cache = new cache_c("dcache", l2cache_size, l2cache_assoc, l2cache_line_size,
                                   sizeof(cache_data_t), l2cache_banks, false, -1, CACHE_DL2, false, 1, 0, this);
 
+  // Setup shared L2 TLB and page walkers (large pages skip the last levels of the page table)
+  if (m_gpu_params->Enable_TLB) {
+    l2_tlb = new cache_c("l2tlb", m_gpu_params->L2_TLB_Sets, m_gpu_params->L2_TLB_Assoc, m_gpu_params->Page_Size,
+                         sizeof(cache_data_t), 1, false, -1, CACHE_TLB, false, 1, 0, this);
+    m_page_walk_cache = new cache_c("pwc", m_gpu_params->Page_Walk_Cache_Sets, m_gpu_params->Page_Walk_Cache_Assoc, 8,
+                                    sizeof(cache_data_t), 1, false, -1, CACHE_TLB, false, 1, 0, this);
+    m_walker_free_cycle.assign(m_gpu_params->Page_Walkers, 0);
+    m_page_walk_levels = std::max(1, m_gpu_params->Page_Walk_Levels - ((int)log2_int(m_gpu_params->Page_Size) - 12) / 9);
+    m_kernel_tlb_stats = tlb_stats_s();
+  }
+
   // Setup Cores
   for (int core_id = 0; core_id < n_of_cores; core_id++) {
     core_c* core = new core_c(this, core_id, m_cycle);
     core_pointers_v.push_back(core);
     core->attach_l2_cache(l2cache);
   }
+  m_active_cores = core_pointers_v;
+  m_n_retired_cores = 0;
 
   // Pool and memory allocation
   trace_node_pool = new pool_c<warp_trace_info_node_s>(10, "warp_node_pool");
@@ -473,26 +1024,142 @@ void macsim::start_kernel(){
 
 void macsim::end_kernel(){
   vector<pair<int, int>> mem_req_v;
+  vector<pair<uint64_t, uint64_t>> oc_stats_v; // register bank conflict cycles, collector unit stalls
+  vector<double> ipc_v;                          // instructions per cycle of the kernel
+  int min_blocks = max_block_per_core;           // blocks per core (Enable_Occupancy_Model)
+  vector<pair<int, int>> slots_v;                // blocks and warp slots of each core
   // Retire cores
   for (int core_id = 0; core_id < n_of_cores; core_id++) {
     core_c* core = core_pointers_v[core_id];
     c_cycle_total[core_id] = core->get_cycle();  // Initialialized in start_kernel
     c_insts_total[core_id] += core->get_insts();
     c_stall_cycles[core_id] += core->get_stall_cycles();
+    n_dep_stalls += core->c_dep_stalls;
+    n_load_use_stalls += core->c_load_use_stalls;
+    n_coalescer_insts += core->c_coalescer_insts;
+    n_coalescer_units += core->c_coalescer_units;
+    n_l1_mshr_merges += core->c_l1_mshr_merges;
+    n_mshr_stalls += core->c_mshr_stalls;
+    n_barriers += core->c_barriers_released;
+    n_barrier_waits += core->c_barrier_waits;
+    n_barrier_wait_cycles += core->c_barrier_wait_cycles;
+    n_shmem_insts += core->c_shmem_insts;
+    n_shmem_conflict_insts += core->c_shmem_conflict_insts;
+    n_shmem_wavefronts += core->c_shmem_wavefronts;
+    n_shmem_conflict_cycles += core->c_shmem_conflict_cycles;
+    n_ldst_stalls += core->c_ldst_stalls;
+    for (int fu = 0; fu < NUM_FUNC_UNIT_TYPES; fu++) {
+      n_fu_issued[fu] += core->c_fu_issued[fu];
+      n_fu_stalls[fu] += core->c_fu_stalls[fu];
+    }
+    n_rf_reads += core->c_rf_reads;
+    n_rf_conflict_reads += core->c_rf_conflict_reads;
+    n_rf_conflict_cycles += core->c_rf_conflict_cycles;
+    n_oc_stalls += core->c_oc_stalls;
+    oc_stats_v.push_back(make_pair(core->c_rf_conflict_cycles, core->c_oc_stalls));
+    sim_time_type kernel_cycles = core->get_cycle() - m_kernel_start_cycle;
+    ipc_v.push_back(kernel_cycles ? (double)core->get_insts() / kernel_cycles : 0.0);
+    min_blocks = std::min(min_blocks, core->c_max_running_block_num);
+    slots_v.push_back(make_pair(core->c_max_running_block_num, core->c_max_running_warp_num));
+    n_const_accesses += core->c_const_accesses;
+    n_const_hits += core->c_const_hits;
+    n_const_l2_hits += core->c_const_l2_hits;
+    n_local_loads += core->c_local_loads;
+    n_local_stores += core->c_local_stores;
+    n_local_l1_hits += core->c_local_l1_hits;
+    m_kernel_tlb_stats.l1_accesses += core->c_tlb_accesses;
+    m_kernel_tlb_stats.l1_misses += core->c_tlb_misses;
+    for (int op = 0; op < NUM_CACHE_OP_TYPES; op++) {
+      n_cop_accesses[op] += core->c_cop_accesses[op];
+      n_cop_l1_hits[op] += core->c_cop_l1_hits[op];
+      n_cop_l1_bypasses[op] += core->c_cop_l1_bypasses[op];
+    }
+    n_l1_prefetches += core->c_l1_prefetches;
+    n_l2_prefetches += core->c_l2_prefetches;
+    n_redundant_prefetches += core->c_redundant_prefetches;
+    n_dropped_prefetches += core->c_dropped_prefetches;
+    n_tlb_dropped_prefetches += core->c_tlb_dropped_prefetches;
+    n_atomic_insts += core->c_atomic_insts;
+    n_icache_accesses += core->c_icache_accesses;
+    n_icache_misses += core->c_icache_misses;
+    n_icache_l2_hits += core->c_icache_l2_hits;
+    n_fetched_insts += core->c_fetched_insts;
+    n_fetch_stalls += core->c_fetch_stalls;
+    for (int fu = 0; fu <= NUM_FUNC_UNIT_TYPES; fu++)
+      n_energy_insts[fu] += core->c_energy_insts[fu];
+    n_vta_lookups += core->c_vta_lookups;
+    n_simt_insts += core->c_simt_insts;
+    n_simt_active_lanes += core->c_simt_active_lanes;
+    n_branches += core->c_branches;
+    n_divergent_branches += core->c_divergent_branches;
+    n_simt_warps += core->c_simt_warps;
+    min_warp_simt_eff = std::min(min_warp_simt_eff, core->c_min_warp_simt_eff);
+    max_warp_simt_eff = std::max(max_warp_simt_eff, core->c_max_warp_simt_eff);
+    sum_warp_simt_eff += core->c_sum_warp_simt_eff;
+    for (int b = 0; b < SIMT_EFF_BUCKETS; b++)
+      n_warp_simt_eff[b] += core->c_warp_simt_eff[b];
+    for (auto& pc : core->c_simt_pc_stats) {
+      simt_pc_stats_s& total = m_simt_pc_stats[make_pair(kernel_id, pc.first)];
+      total.insts += pc.second.insts;
+      total.active_lanes += pc.second.active_lanes;
+    }
+    m_gto_last_warp_id[core_id] = core->c_gto_last_warp_id;
     mem_req_v.push_back(make_pair(core->ld_req_cnt, core->st_req_cnt));
     delete core;
   }
   core_pointers_v.clear();
+  m_active_cores.clear();
   delete l2cache;
+  delete l2_tlb;
+  delete m_page_walk_cache;
+  l2_tlb = m_page_walk_cache = NULL;
 
   cout << "========== kernel " << kernel_id << " summary ==========" << endl;
   for (int core_id = 0; core_id < n_of_cores; core_id++){
     printf("Core: %d\n", core_id);
     printf("\tCORE%d_TOT_CYCLES   : %lu\n", core_id, c_cycle_total[core_id]);
+    if (m_gpu_params->Enable_Clock_Domains)
+      printf("\tCORE%d_TOT_TIME_NS  : %.2f\n", core_id, m_core_clock.ns(c_cycle_total[core_id]));
     printf("\tCORE%d_STALL_CYCLES : %lu\n", core_id, c_stall_cycles[core_id]);
     printf("\tCORE%d_LD_INSTR     : %u\n", core_id, mem_req_v[core_id].first);
     printf("\tCORE%d_ST_INSTR     : %u\n", core_id, mem_req_v[core_id].second);
     printf("\tCORE%d_TOT_INSTR    : %lu\n", core_id, c_cycle_total[core_id]);
+    if (m_gpu_params->Enable_Operand_Collector) {
+      printf("\tCORE%d_RF_CONFLICT_CYCLES : %lu\n", core_id, oc_stats_v[core_id].first);
+      printf("\tCORE%d_OC_STALLS          : %lu\n", core_id, oc_stats_v[core_id].second);
+    }
+    if (!m_gpu_params->Core_Overrides.empty()) {
+      printf("\tCORE%d_POLICY       : %s\n", core_id, Warp_Scheduling_Policy_Types_str[(int)m_core_configs[core_id].policy]);
+      printf("\tCORE%d_IPC          : %.4f\n", core_id, ipc_v[core_id]);
+      if (m_gpu_params->Enable_Occupancy_Model) {
+        printf("\tCORE%d_BLOCKS       : %d\n", core_id, slots_v[core_id].first);
+        printf("\tCORE%d_WARP_SLOTS   : %d\n", core_id, slots_v[core_id].second);
+      }
+    }
+  }
+  if (m_gpu_params->Enable_Occupancy_Model) {
+    int max_warps = m_gpu_params->Core_Max_Threads / 32;
+    int warps = min_blocks * kernel_info_v[kernel_id].n_warp_per_block;
+    // Fewer blocks than the resources allow: the warp slots of the core (Max_Warp_Per_Core) limit them
+    Occupancy_Limiter_Types limiter = min_blocks < max_block_per_core ? Occupancy_Limiter_Types::WARPS
+                                                                      : m_occupancy_limiter;
+    printf("Occupancy:\n");
+    printf("\tBLOCKS_PER_CORE         : %d\n", min_blocks);
+    printf("\tWARPS_PER_CORE          : %d\n", warps);
+    printf("\tTHEORETICAL_OCC_PERC    : %.2f\n", max_warps ? warps * 100.0 / max_warps : 0.0);
+    printf("\tOCCUPANCY_LIMITER       : %s\n", Occupancy_Limiter_Types_str[(int)limiter]);
+  }
+  if (m_gpu_params->Enable_TLB) {
+    printf("TLB:\n");
+    print_tlb_stats(m_kernel_tlb_stats);
+    m_tlb_stats.l1_accesses += m_kernel_tlb_stats.l1_accesses;
+    m_tlb_stats.l1_misses += m_kernel_tlb_stats.l1_misses;
+    m_tlb_stats.merged_misses += m_kernel_tlb_stats.merged_misses;
+    m_tlb_stats.l2_accesses += m_kernel_tlb_stats.l2_accesses;
+    m_tlb_stats.l2_misses += m_kernel_tlb_stats.l2_misses;
+    m_tlb_stats.walk_mem_reads += m_kernel_tlb_stats.walk_mem_reads;
+    m_tlb_stats.walk_queue_cycles += m_kernel_tlb_stats.walk_queue_cycles;
+    m_tlb_stats.miss_latency += m_kernel_tlb_stats.miss_latency;
   }
 
   sim_time_type maxCycleValue = std::numeric_limits<sim_time_type>::min();
@@ -546,8 +1213,9 @@ void macsim::insert_block(warp_trace_info_node_s *node){
 
 int macsim::dispatch_warps(int core_id, Block_Scheduling_Policy_Types policy){
   int ndispatched_warps=0;
-  for(int core_id_ = 0; core_id_ < n_of_cores; core_id_++){
-    if (core_id != -1 && core_id_ != core_id) continue; 
+  int first_core = (core_id == -1) ? 0 : core_id;
+  int last_core = (core_id == -1) ? n_of_cores - 1 : core_id;
+  for(int core_id_ = first_core; core_id_ <= last_core; core_id_++){
     warp_trace_info_node_s* warp_to_run;
     core_c* core = core_pointers_v[core_id_];
 
@@ -574,7 +1242,7 @@ int macsim::dispatch_warps(int core_id, Block_Scheduling_Policy_Types policy){
       warp_to_run->trace_info_ptr->ccws_lls_score = CCWS_LLS_BASE_SCORE;
             
       // Dispatch the warp to the core
-      core->c_dispatched_warps.push_back(warp_to_run->trace_info_ptr);
+      core->c_warp_slots.add(warp_to_run->trace_info_ptr);
       ndispatched_warps++;
     }
   } 
@@ -582,6 +1250,29 @@ int macsim::dispatch_warps(int core_id, Block_Scheduling_Policy_Types policy){
   return ndispatched_warps;
 }
 
+bool macsim::can_dispatch_warps(int core_id){
+  core_c* core = core_pointers_v[core_id];
+  if (core->get_running_warp_num() >= core->get_max_running_warp_num())
+    return false;
+
+  // Same checks as schedule_blocks_rr() (at(): no insertion while other cores read the maps)
+  int fetching_block_id = core->c_fetching_block_id;
+  if (fetching_block_id != -1 && !m_block_schedule_info.at(fetching_block_id)->retired) {
+    if (!m_block_queue->at(fetching_block_id)->empty())
+      return true;
+    if (core->has_suspended_warp_of_block(fetching_block_id)) return false;
+    return true;  // block would retire
+  }
+
+  if (core->c_running_block_num >= core->c_max_running_block_num) return false;
+  for (auto I = m_block_list.begin(), E = m_block_list.end(); I != E; ++I) {
+    int block_id = (*I).first;
+    if (!(m_block_schedule_info.at(block_id)->start_to_fetch) && m_block_schedule_info.at(block_id)->trace_exist)
+      return true;
+  }
+  return false;
+}
+
 warp_s* macsim::initialize_warp(int warp_id){
   warp_s* trace_info = warp_pool->acquire_entry();
 
@@ -622,9 +1313,7 @@ int macsim::schedule_blocks_rr(int core_id){
     list<warp_trace_info_node_s *> *block_list = (*m_block_queue)[fetching_block_id];
     if (block_list->empty() && !m_block_schedule_info[fetching_block_id]->retired){
       // check every warp that is suspended. if any of them belong to fetching_block_id, return -1
-      for (const auto& pair: core->c_suspended_warps){
-        if (pair.second->block_id == fetching_block_id) return -1;
-      }
+      if (core->has_suspended_warp_of_block(fetching_block_id)) return -1;
       m_block_schedule_info[fetching_block_id]->retired = true;
       core->c_running_block_num--;
     }
@@ -638,7 +1327,7 @@ int macsim::schedule_blocks_rr(int core_id){
   }
 
   // If there is not enough space in dispatch queue to enqueue all threads of a block, we return -1
-  if (core->c_running_block_num >= max_block_per_core) return -1;
+  if (core->c_running_block_num >= core->c_max_running_block_num) return -1;
   
   // Find a new block to schedule
   int new_block_id = -1;
@@ -673,9 +1362,68 @@ warp_trace_info_node_s* macsim::fetch_warp_from_block(int block_id) {
 }
 
 bool macsim::is_every_core_retired() {
-  for (int core_id = 0; core_id < n_of_cores; core_id++)
-    if (!core_pointers_v[core_id]->is_retired()) return false;
-  return true;
+  return m_n_retired_cores == n_of_cores;
+}
+
+void macsim::print_tlb_stats(const tlb_stats_s& stats) {
+  printf("\tL1_TLB_ACCESSES         : %lu\n", stats.l1_accesses);
+  printf("\tL1_TLB_MISSES           : %lu\n", stats.l1_misses);
+  printf("\tL1_TLB_MISS_RATE_PERC   : %.2f\n", stats.l1_accesses ? stats.l1_misses * 100.0 / stats.l1_accesses : 0.0);
+  printf("\tL1_TLB_MERGED_MISSES    : %lu\n", stats.merged_misses);
+  printf("\tL2_TLB_ACCESSES         : %lu\n", stats.l2_accesses);
+  printf("\tL2_TLB_MISSES           : %lu\n", stats.l2_misses);
+  printf("\tL2_TLB_MISS_RATE_PERC   : %.2f\n", stats.l2_accesses ? stats.l2_misses * 100.0 / stats.l2_accesses : 0.0);
+  printf("\tPAGE_WALK_MEM_READS     : %lu\n", stats.walk_mem_reads);
+  printf("\tPAGE_WALK_QUEUE_CYCLES  : %lu\n", stats.walk_queue_cycles);
+  printf("\tAVG_TLB_MISS_LATENCY    : %.2f\n", stats.l1_misses ? (float)stats.miss_latency / stats.l1_misses : 0.0);
+}
+
+void macsim::print_clock_stats() {
+  printf("\tCORE_CLOCK_MHZ          : %d\n", m_core_clock.mhz());
+  printf("\tL2_CLOCK_MHZ            : %d\n", m_l2_clock.mhz());
+  printf("\tDRAM_CLOCK_MHZ          : %d\n", m_dram_clock.mhz());
+  printf("\tCORE_CYCLES             : %lu\n", m_cycle);
+  printf("\tL2_CYCLES               : %lu\n", m_l2_clock.cycles_at(m_cycle));
+  printf("\tDRAM_CYCLES             : %lu\n", dram_cycle());
+  printf("\tSIM_TIME_NS             : %.2f\n", m_core_clock.ns(m_cycle));
+  printf("\tAVG_RESPONSE_LATENCY_NS : %.2f\n", n_responses ? m_core_clock.ns(total_latency) / n_responses : 0.0);
+}
+
+void macsim::print_energy_stats(uint64_t n_insts) {
+  GPU_Parameter_Set* p = m_gpu_params;
+
+  // Per event energies are in pJ
+  double inst_energy[] = {p->Energy_SP_Inst, p->Energy_DP_Inst, p->Energy_SFU_Inst, p->Energy_LDST_Inst,
+                          p->Energy_Tensor_Inst, p->Energy_Other_Inst};
+  double inst_pj = 0.0;
+  for (int fu = 0; fu <= NUM_FUNC_UNIT_TYPES; fu++)
+    inst_pj += n_energy_insts[fu] * inst_energy[fu];
+  double l1_pj = n_l1_hits * p->Energy_L1_Hit + (n_cache_req - n_l1_hits) * p->Energy_L1_Miss;
+  double l2_pj = n_l2_hits * p->Energy_L2_Hit + (n_l2_accesses - n_l2_hits) * p->Energy_L2_Miss;
+  double dram_pj = n_dram_reads * p->Energy_DRAM_Read + n_dram_writes * p->Energy_DRAM_Write;
+  double vta_pj = n_vta_lookups * p->Energy_VTA_Lookup;
+  double static_pj = (double)m_cycle * n_of_cores * p->Energy_Leakage_Per_Core_Cycle;
+  double total_pj = inst_pj + l1_pj + l2_pj + dram_pj + vta_pj + static_pj;
+  double time_ns = m_core_clock.ns(m_cycle);
+
+  for (int fu = 0; fu <= NUM_FUNC_UNIT_TYPES; fu++) {
+    string name = fu < NUM_FUNC_UNIT_TYPES ? Func_Unit_Types_str[fu] : "OTHER";
+    printf("\t%-24s: %lu\n", (name + "_INSTS").c_str(), n_energy_insts[fu]);
+  }
+  printf("\tL2_ACCESSES             : %lu\n", n_l2_accesses);
+  printf("\tL2_HITS                 : %lu\n", n_l2_hits);
+  printf("\tDRAM_READS              : %lu\n", n_dram_reads);
+  printf("\tDRAM_WRITES             : %lu\n", n_dram_writes);
+  printf("\tVTA_LOOKUPS             : %lu\n", n_vta_lookups);
+  printf("\tINST_ENERGY_NJ          : %.2f\n", inst_pj / 1e3);
+  printf("\tL1_ENERGY_NJ            : %.2f\n", l1_pj / 1e3);
+  printf("\tL2_ENERGY_NJ            : %.2f\n", l2_pj / 1e3);
+  printf("\tDRAM_ENERGY_NJ          : %.2f\n", dram_pj / 1e3);
+  printf("\tVTA_ENERGY_NJ           : %.2f\n", vta_pj / 1e3);
+  printf("\tSTATIC_ENERGY_NJ        : %.2f\n", static_pj / 1e3);
+  printf("\tTOTAL_ENERGY_NJ         : %.2f\n", total_pj / 1e3);
+  printf("\tAVG_POWER_W             : %.3f\n", time_ns > 0 ? total_pj / 1e3 / time_ns : 0.0);
+  printf("\tINSTR_PER_JOULE         : %.4e\n", total_pj > 0 ? n_insts / (total_pj * 1e-12) : 0.0);
 }
 
 void macsim::print_stats() {
@@ -701,7 +1449,192 @@ void macsim::print_stats() {
   
   float ipc = (float)n_total_instrs_retired/(float)m_cycle;
   printf("\tINSTR_PER_CYCLE         : %lf\n", ipc);
+  if (!m_opcode_latency.empty())
+    printf("\tNUM_DEPENDENCY_STALLS   : %lu\n", n_dep_stalls);
+  if (m_gpu_params->Non_Blocking_Loads)
+    printf("\tNUM_LOAD_USE_STALLS     : %lu\n", n_load_use_stalls);
   
+  if (m_gpu_params->Enable_Coalescer) {
+    printf("Coalescer:\n");
+    printf("\tCOALESCER_MEM_INSTRS    : %lu\n", n_coalescer_insts);
+    printf("\tCOALESCER_ACCESSES      : %lu\n", n_coalescer_units);
+    printf("\tACCESSES_PER_MEM_INSTR  : %.2f\n", n_coalescer_insts ? (float)n_coalescer_units / n_coalescer_insts : 0.0);
+  }
+
+  if (m_gpu_params->Enable_Func_Units) {
+    int fu_units[] = {m_gpu_params->FU_SP_Units, m_gpu_params->FU_DP_Units, m_gpu_params->FU_SFU_Units,
+                      m_gpu_params->FU_LDST_Units, m_gpu_params->FU_Tensor_Units};
+    int fu_ii[] = {m_gpu_params->FU_SP_II, m_gpu_params->FU_DP_II, m_gpu_params->FU_SFU_II,
+                   m_gpu_params->FU_LDST_II, m_gpu_params->FU_Tensor_II};
+    printf("FuncUnits:\n");
+    for (int fu = 0; fu < NUM_FUNC_UNIT_TYPES; fu++) {
+      // Share of the issue capacity of the unit used over the run
+      double capacity = (double)fu_units[fu] * m_cycle * n_of_cores / std::max(fu_ii[fu], 1);
+      string name = string("FU_") + Func_Unit_Types_str[fu];
+      printf("\t%-24s: %lu\n", (name + "_ISSUED").c_str(), n_fu_issued[fu]);
+      printf("\t%-24s: %lu\n", (name + "_STALLS").c_str(), n_fu_stalls[fu]);
+      printf("\t%-24s: %.2f\n", (name + "_UTIL_PERC").c_str(), capacity ? n_fu_issued[fu] * 100.0 / capacity : 0.0);
+    }
+  }
+
+  if (m_gpu_params->Enable_SIMT_Stats) {
+    printf("SIMT:\n");
+    printf("\tSIMT_INSTRS             : %lu\n", n_simt_insts);
+    printf("\tAVG_ACTIVE_LANES        : %.2f\n", n_simt_insts ? (float)n_simt_active_lanes / n_simt_insts : 0.0);
+    printf("\tSIMT_EFFICIENCY_PERC    : %.2f\n", n_simt_insts ? (float)n_simt_active_lanes * 100.0 / (32.0 * n_simt_insts) : 0.0);
+    printf("\tLOST_LANE_SLOTS         : %lu\n", 32 * n_simt_insts - n_simt_active_lanes);
+    printf("\tNUM_BRANCHES            : %lu\n", n_branches);
+    printf("\tNUM_DIVERGENT_BRANCHES  : %lu\n", n_divergent_branches);
+    printf("\tMIN_WARP_SIMT_EFF_PERC  : %.2f\n", n_simt_warps ? min_warp_simt_eff * 100.0 : 0.0);
+    printf("\tMAX_WARP_SIMT_EFF_PERC  : %.2f\n", n_simt_warps ? max_warp_simt_eff * 100.0 : 0.0);
+    printf("\tAVG_WARP_SIMT_EFF_PERC  : %.2f\n", n_simt_warps ? sum_warp_simt_eff * 100.0 / n_simt_warps : 0.0);
+    // Finished warps by SIMT efficiency: the warps a lane-utilization aware scheduler would favour
+    for (int b = 0; b < SIMT_EFF_BUCKETS; b++) {
+      int lo = b * 100 / SIMT_EFF_BUCKETS, hi = (b + 1) * 100 / SIMT_EFF_BUCKETS;
+      printf("\t%-24s: %lu\n", ("WARPS_SIMT_EFF_" + to_string(lo) + "_" + to_string(hi)).c_str(), n_warp_simt_eff[b]);
+    }
+
+    // Instructions losing the most lanes
+    vector<pair<uint64_t, pair<int, uint64_t>>> lost;
+    for (auto& pc : m_simt_pc_stats)
+      lost.push_back(make_pair(32 * pc.second.insts - pc.second.active_lanes, pc.first));
+    int n_top = std::min<int>(lost.size(), m_gpu_params->SIMT_Stats_Top_PCs);
+    partial_sort(lost.begin(), lost.begin() + n_top, lost.end(), greater<pair<uint64_t, pair<int, uint64_t>>>());
+    for (int i = 0; i < n_top; i++) {
+      const simt_pc_stats_s& pc = m_simt_pc_stats[lost[i].second];
+      printf("\tK%d_PC_0x%lx_ACTIVE_LANES : %.2f (%lu instrs)\n", lost[i].second.first, lost[i].second.second,
+             (float)pc.active_lanes / pc.insts, pc.insts);
+    }
+  }
+
+  if (m_gpu_params->Shared_Mem_Bank_Model) {
+    printf("SharedMem:\n");
+    printf("\tSHMEM_INSTRS            : %lu\n", n_shmem_insts);
+    printf("\tSHMEM_CONFLICT_INSTRS   : %lu\n", n_shmem_conflict_insts);
+    printf("\tSHMEM_WAVEFRONTS        : %lu\n", n_shmem_wavefronts);
+    printf("\tSHMEM_CONFLICT_CYCLES   : %lu\n", n_shmem_conflict_cycles);
+    printf("\tWAVEFRONTS_PER_INSTR    : %.2f\n", n_shmem_insts ? (float)n_shmem_wavefronts / n_shmem_insts : 0.0);
+    printf("\tLDST_PIPE_STALLS        : %lu\n", n_ldst_stalls);
+  }
+
+  if (m_gpu_params->Enable_Barriers) {
+    printf("Barrier:\n");
+    printf("\tNUM_BARRIERS            : %lu\n", n_barriers);
+    printf("\tBARRIER_WAITS           : %lu\n", n_barrier_waits);
+    printf("\tBARRIER_WAIT_CYCLES     : %lu\n", n_barrier_wait_cycles);
+  }
+
+  if (m_gpu_params->Enable_Const_Cache) {
+    printf("ConstCache:\n");
+    printf("\tCONST_NUM_ACCESSES      : %lu\n", n_const_accesses);
+    printf("\tCONST_NUM_HITS          : %lu\n", n_const_hits);
+    printf("\tCONST_HIT_RATE_PERC     : %.2f\n", n_const_accesses ? n_const_hits * 100.0 / n_const_accesses : 0.0);
+    printf("\tCONST_L2_HITS           : %lu\n", n_const_l2_hits);
+  }
+
+  if (m_gpu_params->Enable_Local_Mem_Space) {
+    printf("LocalMem:\n");
+    printf("\tLOCAL_L1_POLICY         : %s\n", Local_Mem_L1_Policy_Types_str[(int)m_gpu_params->Local_Mem_L1_Policy]);
+    printf("\tLOCAL_LD_ACCESSES       : %lu\n", n_local_loads);
+    printf("\tLOCAL_ST_ACCESSES       : %lu\n", n_local_stores);
+    printf("\tLOCAL_L1_HITS           : %lu\n", n_local_l1_hits);
+  }
+
+  if (m_gpu_params->Enable_TLB) {
+    printf("TLB:\n");
+    printf("\tPAGE_SIZE               : %d\n", m_gpu_params->Page_Size);
+    print_tlb_stats(m_tlb_stats);
+  }
+
+  if (m_gpu_params->Enable_UVM) {
+    printf("UVM:\n");
+    printf("\tUVM_PAGE_FAULTS         : %lu\n", n_uvm_faults);
+    printf("\tUVM_FAULT_BATCHES       : %lu\n", n_uvm_batches);
+    printf("\tAVG_FAULTS_PER_BATCH    : %.2f\n", n_uvm_batches ? (float)n_uvm_faults / n_uvm_batches : 0.0);
+    printf("\tUVM_MIGRATED_PAGES      : %lu\n", n_uvm_migrated_pages);
+    printf("\tUVM_PREFETCHED_PAGES    : %lu\n", n_uvm_prefetched_pages);
+    printf("\tUVM_MIGRATED_BYTES      : %lu\n", n_uvm_migrated_pages * m_gpu_params->Page_Size);
+    printf("\tUVM_HANDLER_BUSY_CYCLES : %lu\n", n_uvm_batch_cycles);
+  }
+
+  if (m_gpu_params->Enable_Clock_Domains) {
+    printf("Clocks:\n");
+    print_clock_stats();
+  }
+
+  if (m_gpu_params->Enable_Energy_Model) {
+    printf("Energy:\n");
+    print_energy_stats(n_total_instrs_retired);
+  }
+
+  if (m_gpu_params->Enable_Cache_Operators) {
+    printf("CacheOperators:\n");
+    for (int op = 0; op < NUM_CACHE_OP_TYPES; op++) {
+      if (n_cop_accesses[op] == 0)
+        continue;
+      string name = string("COP_") + Cache_Op_Types_str[op];
+      printf("\t%-24s: %lu\n", (name + "_ACCESSES").c_str(), n_cop_accesses[op]);
+      printf("\t%-24s: %lu\n", (name + "_L1_HITS").c_str(), n_cop_l1_hits[op]);
+      printf("\t%-24s: %lu\n", (name + "_L1_BYPASSES").c_str(), n_cop_l1_bypasses[op]);
+    }
+    printf("\tL1_PREFETCHES           : %lu\n", n_l1_prefetches);
+    printf("\tL2_PREFETCHES           : %lu\n", n_l2_prefetches);
+    printf("\tREDUNDANT_PREFETCHES    : %lu\n", n_redundant_prefetches);
+    if (m_gpu_params->Enable_MSHR)
+      printf("\tDROPPED_PREFETCHES      : %lu\n", n_dropped_prefetches);
+    if (m_gpu_params->Enable_TLB)
+      printf("\tTLB_DROPPED_PREFETCHES  : %lu\n", n_tlb_dropped_prefetches);
+  }
+
+  if (m_gpu_params->Enable_L2_Atomics) {
+    printf("Atomics:\n");
+    printf("\tATOMIC_INSTRS           : %lu\n", n_atomic_insts);
+    printf("\tATOMIC_REQUESTS         : %lu\n", n_atomic_requests);
+    printf("\tATOMIC_OPS              : %lu\n", n_atomic_ops);
+    printf("\tATOMIC_L2_MISSES        : %lu\n", n_atomic_l2_misses);
+    printf("\tATOMIC_CONTENDED_REQS   : %lu\n", n_atomic_contended);
+    printf("\tATOMIC_WAIT_CYCLES      : %lu\n", n_atomic_wait_cycles);
+    printf("\tAVG_ATOMIC_LATENCY      : %.2f\n", n_atomic_requests ? (float)n_atomic_latency / n_atomic_requests : 0.0);
+
+    // Most contended lines
+    vector<pair<uint64_t, Addr>> contended;
+    for (auto& line : m_atomic_line_stats)
+      contended.push_back(make_pair(line.second.wait_cycles, line.first));
+    int n_top = std::min<int>(contended.size(), m_gpu_params->Atomic_Stats_Top_Lines);
+    partial_sort(contended.begin(), contended.begin() + n_top, contended.end(), greater<pair<uint64_t, Addr>>());
+    for (int i = 0; i < n_top; i++) {
+      const atomic_line_stats_s& line = m_atomic_line_stats[contended[i].second];
+      printf("\tLINE_0x%llx_ATOMIC_WAIT_CYCLES : %lu (%lu requests, %lu ops)\n", contended[i].second,
+             line.wait_cycles, line.requests, line.ops);
+    }
+  }
+
+  if (m_gpu_params->Enable_Operand_Collector) {
+    printf("OperandCollector:\n");
+    printf("\tRF_READS                : %lu\n", n_rf_reads);
+    printf("\tRF_BANK_CONFLICT_READS  : %lu\n", n_rf_conflict_reads);
+    printf("\tRF_BANK_CONFLICT_CYCLES : %lu\n", n_rf_conflict_cycles);
+    printf("\tOC_FULL_STALLS          : %lu\n", n_oc_stalls);
+  }
+
+  if (m_gpu_params->Enable_ICache) {
+    printf("ICache:\n");
+    printf("\tICACHE_NUM_ACCESSES     : %lu\n", n_icache_accesses);
+    printf("\tICACHE_NUM_MISSES       : %lu\n", n_icache_misses);
+    printf("\tICACHE_MISS_RATE_PERC   : %.2f\n", n_icache_accesses ? n_icache_misses * 100.0 / n_icache_accesses : 0.0);
+    printf("\tICACHE_L2_HITS          : %lu\n", n_icache_l2_hits);
+    printf("\tFETCHED_INSTRS          : %lu\n", n_fetched_insts);
+    printf("\tFETCH_STALLS            : %lu\n", n_fetch_stalls);
+  }
+
+  if (m_gpu_params->Enable_MSHR) {
+    printf("MSHR:\n");
+    printf("\tL1_MSHR_MERGES          : %lu\n", n_l1_mshr_merges);
+    printf("\tL1_MSHR_FULL_STALLS     : %lu\n", n_mshr_stalls);
+    printf("\tL2_MSHR_MERGES          : %lu\n", n_l2_mshr_merges);
+    printf("\tL2_MSHR_FULL_WAITS      : %lu\n", n_l2_mshr_waits);
+  }
+
   printf("Cache:\n");
   if (m_gpu_params->Enable_GPU_Cache) {
     printf("\tCACHE_NUM_ACCESSES    : %lu\n", n_cache_req);
@@ -714,6 +1647,9 @@ void macsim::print_stats() {
   else { 
       PRINT_MESSAGE("GPU cache disabled");
   }
+
+  if (m_optimistic)
+    m_optimistic->print_stats();
   printf("\n========================================\n");
 }
 
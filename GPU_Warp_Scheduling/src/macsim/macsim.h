@@ -3,9 +3,12 @@
 
 #include <string>
 #include <queue>
+#include <deque>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <limits>
 
 #include "sim_defs.h"
 #include "utils/utils.h"
@@ -13,16 +16,24 @@
 
 #include "exec/GPU_Parameter_Set.h"
 #include "ram.h"
+#include "clock_domain.h"
 
 using namespace std;
 
 #define CCWS_LLS_BASE_SCORE 100
 #define CCWS_LLS_K_THROTTLE 64
 #define CCWS_VTA_ASSOC 8
+#define PENDING_LOAD_CYCLE std::numeric_limits<sim_time_type>::max()
+#define MAX_BLOCK_BARRIERS 16   // named barriers per block (BAR id)
+#define INST_ADDR_BASE (1ULL << 62)  // instruction fetches in L2 and memory, apart from data addresses
+#define LOCAL_ADDR_BASE (1ULL << 61) // local memory of the warps (Enable_Local_Mem_Space)
+#define UVM_FAULT_PENDING ((sim_time_type)-1) // translation waiting for its page fault to be serviced
+#define SIMT_EFF_BUCKETS 4      // ranges of the SIMT efficiency of finished warps (25% each)
 
 class core_c;
 class GPU_Parameter_Set;
 class cache_c;
+class optimistic_c;
 
 typedef struct cache_data_t {
   bool m_dirty;           /**< line dirty */
@@ -38,14 +49,94 @@ typedef struct kernel_info_s {
   vector<tuple<int, int, int>> warp_id_v; // warp_id, warp_start_inst_count, warp_total_inst
 
   Counter inst_count_total = 0;
+
+  // Resources of a block (trace_resources.txt, -1: not given)
+  int regs_per_thread = -1;
+  int shared_mem_per_block = -1;
+  int threads_per_block = -1;
 } kernel_info_s;
 
+// Resource that limits the blocks of a kernel on a core (Enable_Occupancy_Model)
+enum class Occupancy_Limiter_Types {
+  BLOCKS = 0,
+  WARPS,
+  REGISTERS,
+  SHARED_MEM,
+};
+
+constexpr const char* Occupancy_Limiter_Types_str[] = {
+  "BLOCKS",
+  "WARPS",
+  "REGISTERS",
+  "SHARED_MEM"
+};
+
+// Load in flight while its warp keeps issuing (Non_Blocking_Loads)
+struct pending_load_s {
+  uint16_t dst[MAX_NVBIT_DST_NUM];  // destination registers, dst[0] identifies the load in the response
+  int n_dst;
+  int n_wait;                       // responses still expected (one per coalesced request)
+};
+
+// Memory response delivered to a core
+struct core_mem_response_s {
+  int slot_id;    // warp slot of the requesting warp
+  int dst_reg;    // first destination register of a load (-1: none)
+  Addr addr;      // request address
+  bool l1_miss;   // L1 read miss: answers the requests merged into the L1 MSHR entry of the line
+  bool ifetch;    // instruction cache miss: addr is the instruction line
+  bool tlb;       // translation done (Enable_TLB): addr is the page
+};
+
+// SIMT statistics of an instruction address
+struct simt_pc_stats_s {
+  uint64_t insts = 0;         // warp instructions committed
+  uint64_t active_lanes = 0;  // their active threads
+};
+
+// Atomic operations on an L2 line
+struct atomic_line_stats_s {
+  uint64_t requests = 0;      // atomic requests (one per warp instruction and line)
+  uint64_t ops = 0;           // thread operations
+  uint64_t wait_cycles = 0;   // cycles requests waited for the operations queued before them
+};
+
+// Address translation counters (Enable_TLB)
+struct tlb_stats_s {
+  uint64_t l1_accesses = 0;       // L1 TLB lookups (one per page touched by a memory instruction)
+  uint64_t l1_misses = 0;
+  uint64_t merged_misses = 0;     // L1 TLB misses on a page whose translation is already in flight
+  uint64_t l2_accesses = 0;       // shared L2 TLB lookups (the other L1 TLB misses)
+  uint64_t l2_misses = 0;         // of those, misses: page walks
+  uint64_t walk_mem_reads = 0;    // page table levels read from memory (not in the page walk cache)
+  uint64_t walk_queue_cycles = 0; // cycles walks waited for a free walker
+  uint64_t miss_latency = 0;      // L1 TLB miss to translation cycles, summed
+};
+
+// Translation of a page for a warp that missed in its L1 TLB
+struct tlb_response_s {
+  int core_id;
+  int slot_id;
+  Addr page;
+  sim_time_type req_time;
+};
+
+// Shared L2 MSHR entry: the request sent to memory for a line and the requests merged into it
+struct l2_mshr_entry_s {
+  uint64_t request_id;              // primary request (scoreboard id)
+  std::vector<uint64_t> merged_ids; // secondary misses, answered by the primary response
+};
+
 typedef struct warp_s {
   gzFile m_trace_file;
 
   // Trace buffer for reading trace file
   const unsigned trace_buffer_size = 32;                  // number of instruction the buffer can hold
-  std::queue <trace_info_nvbit_small_s *> trace_buffer;   // Trace buffer
+  std::deque <trace_info_nvbit_small_s *> trace_buffer;   // Trace buffer
+
+  // Instructions read from the trace file during a rolled back speculative window, consumed before the file
+  std::deque <trace_info_nvbit_small_s *> trace_replay_buffer;
+  std::vector <trace_info_nvbit_small_s *> spec_trace_reads;   // Read from the file in the current window
 
   // TODO: We need to have a per-warp timestamp marker
   sim_time_type timestampMarkerGTO = 0;
@@ -55,12 +146,43 @@ typedef struct warp_s {
 
   // LLS score for warp
   int ccws_lls_score=0;
+
+  // Register scoreboard: cycle at which the pending result of each register is written
+  // (PENDING_LOAD_CYCLE: written by a load still in memory)
+  std::vector<sim_time_type> reg_ready_cycle;
+
+  // Memory requests still in flight (non-blocking), or responses the suspended warp waits for
+  // (blocking), and the non-blocking loads among them
+  int n_mem_pending = 0;
+  std::vector<pending_load_s> pending_loads;
   
   bool m_file_opened;
   bool m_trace_ended;
   // int file_pointer_offset = 0;
   int warp_id;
   int block_id; // this one is different from unique_block_id. for every kernel, the id starts from 0
+  int slot_id = -1;   // warp slot in the core (see warp_slots.h)
+
+  // SIMT efficiency: instructions committed and their active threads (for lane-utilization aware scheduling)
+  uint64_t simt_insts = 0;
+  uint64_t simt_active_lanes = 0;
+
+  // The warp is suspended on an atomic: it commits when the results return (Enable_L2_Atomics)
+  bool atomic_returned = false;
+
+  // Barrier the warp waits at (Warp_Slot_State::BARRIER), and since when
+  int barrier_id = -1;
+  sim_time_type barrier_wait_start = 0;
+
+  // Instruction buffer: the first ibuf_insts instructions of the trace buffer are fetched
+  // (Enable_ICache), and the warp waits for an instruction cache miss if fetch_wait
+  int ibuf_insts = 0;
+  bool fetch_wait = false;
+
+  // Address translation (Enable_TLB): L1 TLB misses of the current instruction in flight, and
+  // tlb_translated once they returned, so that the instruction issues again without a lookup
+  int tlb_walks_pending = 0;
+  bool tlb_translated = false;
 } warp_s;
 
 typedef struct warp_trace_info_node_s {
@@ -69,6 +191,12 @@ typedef struct warp_trace_info_node_s {
   int unique_block_id; /**< block id */
 } warp_trace_info_node_s;
 
+// Named barrier of a block
+typedef struct block_barrier_s {
+  int arrived_warps = 0; /**< warps waiting at the barrier (and the one arriving last) */
+  int expected_warps = 0; /**< warps taking part (0: every live warp of the block) */
+} block_barrier_s;
+
 typedef struct block_schedule_info_s {
   bool start_to_fetch = false; /**< start fetching */
   int dispatched_core_id = -1; /**< core id in which this block is launched */
@@ -78,6 +206,8 @@ typedef struct block_schedule_info_s {
   int total_thread_num = 0; /**< number of total threads */
   // int dispatch_done; /**< dispatch done */
   bool trace_exist = false; /**< trace exist */
+  int finished_warp_num = 0; /**< number of finished warps (barriers wait for the live ones) */
+  block_barrier_s barriers[MAX_BLOCK_BARRIERS]; /**< BAR synchronization state */
   // Counter sched_cycle; /**< scheduled cycle */
   // Counter retire_cycle; /**< retired cycle */
 } block_schedule_info_s;
@@ -96,12 +226,34 @@ enum class Warp_Scheduling_Policy_Types {
   CCWS = 2, 
 };
 
+// L1 policy of local memory accesses (LDL/STL)
+enum class Local_Mem_L1_Policy_Types {
+  GLOBAL = 0,       // like global accesses: loads allocate, stores write through
+  BYPASS,           // served by L2
+  WRITE_ALLOCATE,   // stores allocate too (spilled registers are read back from L1)
+};
+
+constexpr const char* Local_Mem_L1_Policy_Types_str[] = {
+  "GLOBAL",
+  "BYPASS",
+  "WRITE_ALLOCATE"
+};
+
 constexpr const char* Warp_Scheduling_Policy_Types_str[] = {
   "ROUND_ROBIN",
   "GTO",
   "CCWS"
 };
 
+// Parameters a core is built with: the global ones, unless Core_Overrides changes them for the core
+struct core_config_s {
+  int l1cache_size;         // L1Cache_Size
+  int l1cache_assoc;        // L1Cache_Assoc
+  int max_warps;            // Max_Warp_Per_Core (warp slots, also caps those of the occupancy model)
+  int n_schedulers;         // Warp_Schedulers_Per_Core (warps issued per cycle, at least as many warp slots)
+  Warp_Scheduling_Policy_Types policy;  // Warp_Scheduling_Policy
+};
+
 struct GPU_scoreboard_entry {
   Addr addr;
   uint64_t PC;
@@ -109,9 +261,15 @@ struct GPU_scoreboard_entry {
   bool is_mem;
   int core_id;
   int warp_id;
+  int slot_id;                // warp slot in the core, carried back by the response
+  int dst_reg = -1;           // first destination register of a load, carried back by the response
   uint64_t mem_queue_id = -1;
   bool insert_in_l1 = false;  // insert block in l1 also when response returns
   bool mark_dirty = false;    // mark as dirty in L2 when response returns 
+  bool ifetch = false;        // instruction cache miss
+  bool insert_in_const = false; // insert block in the constant cache when response returns
+  bool evict_first = false;   // streaming load (.cs): the block inserted in l1 is the next victim
+  int atomic_ops = 0;         // atomic request: thread operations for the L2 atomic unit
 };
 
 class macsim {
@@ -140,15 +298,74 @@ public:
   // Get average memory latency
   uint32_t get_avg_latency() { return n_responses == 0 ? 0 : total_latency/n_responses; }
 
+  // DRAM cycles elapsed so far (RAM runs in the DRAM clock domain)
+  sim_time_type dram_cycle() { return m_dram_clock.cycles_at(m_cycle); }
+
   // setup trace reader
   void trace_reader_setup();
   
   // Generates memory request for lower level memory model if there is a L2 miss
-  void inst_event(trace_info_nvbit_small_s* trace_info, int core_id, int block_id, int warp_id, sim_time_type c_cycle, bool on_response_insert_in_l1=false, bool on_response_mark_dirty=false);
+  void inst_event(trace_info_nvbit_small_s* trace_info, Addr addr, int access_sz, int core_id, int block_id, int warp_id, int slot_id, sim_time_type c_cycle, bool on_response_insert_in_l1=false, bool on_response_mark_dirty=false,
+                  bool on_response_insert_in_const=false);
   
+  // Generates memory request for an instruction cache miss of a warp that missed in L2 too
+  void ifetch_event(Addr line_addr, int line_size, int core_id, int warp_id, int slot_id);
+
+  // Atomic request of a warp to an L2 line (n_ops thread operations): executed by the L2 atomic unit,
+  // after the line comes from memory on an L2 miss
+  void atomic_event(Addr addr, int access_sz, int n_ops, int core_id, int warp_id, int slot_id, int dst_reg);
+
+  // Queue an atomic request behind the operations on its line, its response returns when done
+  void atomic_unit_enqueue(const GPU_scoreboard_entry& entry);
+
+  // L1 TLB miss of a warp on a page: translated by the shared L2 TLB or a page walk, the response
+  // fills the L1 TLB of the core
+  void tlb_miss(Addr page, int core_id, int slot_id);
+
+  // Page walk of a page starting at cycle start, returns the cycle the translation is done
+  sim_time_type page_walk(Addr page, sim_time_type start);
+
+  // Unified memory: when the fault handler is free, migrate the pages of the faults raised so far
+  // (one batch) from host memory, and answer their translations when the transfer is done
+  void uvm_service_faults();
+
+  // Unified memory: is the page in device memory (migration done)?
+  bool uvm_page_resident(Addr page) const;
+
+  // Print the energy of the counted events and static leakage, average power and energy efficiency
+  void print_energy_stats(uint64_t n_insts);
+
+  // Print core, L2 and DRAM clocks, and the simulated time
+  void print_clock_stats();
+
+  // Print address translation counters
+  void print_tlb_stats(const tlb_stats_s& stats);
+
+  // Send a memory request to RAM (through the L2 MSHR, if enabled)
+  void send_mem_request(const RAM_request& ram_req);
+
+  // Hand a request to RAM, its time crosses into the DRAM clock domain
+  void push_ram_request(RAM_request ram_req);
+
   // Get memory response from memory and 
   void get_mem_response();
 
+  // Insert a line returned from memory in L2, returns true if the evicted line (*victim_addr) must be written back
+  bool fill_l2(Addr addr, bool mark_dirty, Addr* victim_addr);
+
+  // Generate a memory request to write back a dirty L2 line
+  void send_writeback(Addr line_addr);
+
+  // L2 MSHR: merge a request into the entry of its line or allocate one and send it to memory,
+  // returns false if no entry or merge slot is free
+  bool l2_mshr_send(const RAM_request& ram_req);
+
+  // L2 MSHR: send the requests waiting for a free entry, in order
+  void l2_mshr_retry();
+
+  // Deliver a memory response to the requesting core
+  void respond(const GPU_scoreboard_entry& entry);
+
   // Run a cycle
   bool run_a_cycle();
 
@@ -166,11 +383,15 @@ public:
   /**
    * Dispatch warps to specified core
    * if (core_id == -1), dispatch to all cores (used for initialization)
-   * warp_to_run == NULL if there is no more warp to schedule (schedule := put in the core's c_dispatched_warps queue)
+   * warp_to_run == NULL if there is no more warp to schedule (schedule := put in the core's ready warp slots)
    * Returns number of total dispatched warps
   */
   int dispatch_warps(int core_id, Block_Scheduling_Policy_Types policy);
 
+  // Would dispatch_warps() change anything for the core (dispatch a warp, retire or start a block)?
+  // Read only, so speculating cores can call it concurrently.
+  bool can_dispatch_warps(int core_id);
+
   warp_s* initialize_warp(int warp_id);
 
   // Block scheduler
@@ -194,17 +415,39 @@ public:
   // Increment num l1 hits
   void inc_n_l1_hits()   { n_l1_hits++; }
 
+  // Count an L2 data access
+  void count_l2_access(bool hit) { n_l2_accesses++; n_l2_hits += hit; }
+
+  // Reads and writes served by RAM (energy model)
+  void set_dram_accesses(uint64_t reads, uint64_t writes) { n_dram_reads = reads; n_dram_writes = writes; }
+
+  // Build m_opcode_latency from the Latency_* parameters and the Opcode_Latency overrides
+  void init_opcode_latency();
+
+  // Build m_core_configs from the global core parameters and the Core_Overrides of cores and clusters
+  void init_core_configs();
+
+  // Occupancy calculator: blocks of the kernel a core can hold with its threads, registers and
+  // shared memory, and the resource that limits them
+  int occupancy_blocks(const kernel_info_s& kernel, Occupancy_Limiter_Types* limiter);
+
 
   uint64_t global_memory_base_addr = 0;
   
   sim_time_type m_cycle;
+  clock_domain_c m_core_clock;  // Cores (Core_Clock_MHz, for time in ns)
+  clock_domain_c m_l2_clock;    // L2 and interconnect (Enable_Clock_Domains)
+  clock_domain_c m_dram_clock;  // RAM (Enable_Clock_Domains)
   int n_of_cores;
   int max_block_per_core;
+  Occupancy_Limiter_Types m_occupancy_limiter = Occupancy_Limiter_Types::BLOCKS;
   Block_Scheduling_Policy_Types block_scheduling_policy;
   Warp_Scheduling_Policy_Types warp_scheduling_policy;
   int kernel_id = 0;
   vector<string> kernels_v;
   vector<core_c *> core_pointers_v;
+  vector<core_c *> m_active_cores;      /**< cores that have not retired, in core id order */
+  int m_n_retired_cores = 0;            /**< number of retired cores in the current kernel */
   cache_c* l2cache;
   pool_c<warp_trace_info_node_s> *trace_node_pool; /**<  trace node pool */
   pool_c<warp_s> *warp_pool;
@@ -224,6 +467,11 @@ public:
   unordered_map<int, sim_time_type> c_stall_cycles;
   bool gpu_retired = false;
   GPU_Parameter_Set* m_gpu_params;
+  optimistic_c* m_optimistic = NULL;     // Optimistic parallel driver (NULL: serial simulation)
+  vector<vector<int>> m_gto_last_warp_id; // Last warp scheduled by GTO on each core scheduler, kept across kernels
+  vector<int> m_opcode_latency;          // Result latency of each opcode (empty: execution latency not modeled)
+  vector<core_config_s> m_core_configs;  // Parameters of each core
+  sim_time_type m_kernel_start_cycle = 0;
 
   vector<pair<sim_time_type, int>> m_active_chips;
   vector<pair<sim_time_type, int>> m_chip_contention;
@@ -235,6 +483,8 @@ public:
   int m_cycle_post_precondition = 0;
 
 private:
+  friend class optimistic_c;
+
   string kernel_config_path;
   int n_repeat_kernel;
   sim_time_type cur_cycle;
@@ -245,6 +495,70 @@ private:
   uint64_t n_timeout_req; // track number of GPU memory queue request that get a response timeout
   uint64_t n_cache_req;
   uint64_t n_l1_hits;
+  uint64_t n_dep_stalls = 0; // scheduler cycles where every ready warp waited on a register dependency
+  uint64_t n_load_use_stalls = 0; // warps suspended on the first use of a pending load register
+  uint64_t n_coalescer_insts = 0; // memory instructions split by the coalescer
+  uint64_t n_coalescer_units = 0; // line/sector accesses they generated
+  uint64_t n_l1_mshr_merges = 0;  // L1 misses merged into an L1 MSHR entry
+  uint64_t n_mshr_stalls = 0;     // scheduler cycles where every ready warp waited for an L1 MSHR
+  uint64_t n_l2_mshr_merges = 0;  // L2 misses merged into an L2 MSHR entry
+  uint64_t n_l2_mshr_waits = 0;   // L2 misses delayed by a full L2 MSHR
+  uint64_t n_barriers = 0;        // barriers released
+  uint64_t n_barrier_waits = 0;   // warps that waited at a barrier
+  uint64_t n_barrier_wait_cycles = 0; // cycles warps spent waiting at barriers
+  uint64_t n_shmem_insts = 0;     // shared memory instructions
+  uint64_t n_shmem_conflict_insts = 0; // those with bank conflicts
+  uint64_t n_shmem_wavefronts = 0; // cycles the shared memory banks were accessed
+  uint64_t n_shmem_conflict_cycles = 0; // wavefronts replayed because of bank conflicts
+  uint64_t n_ldst_stalls = 0;     // scheduler cycles where every ready warp waited for the LD/ST pipe
+  uint64_t n_fu_issued[NUM_FUNC_UNIT_TYPES] = {}; // instructions issued to each functional unit type
+  uint64_t n_fu_stalls[NUM_FUNC_UNIT_TYPES] = {}; // scheduler cycles where every ready warp waited for the unit
+  uint64_t n_rf_reads = 0;        // source registers read by the operand collectors
+  uint64_t n_rf_conflict_reads = 0; // of those, reads delayed by a register bank conflict
+  uint64_t n_rf_conflict_cycles = 0; // cycles instructions waited for their operands beyond one
+  uint64_t n_oc_stalls = 0;       // scheduler cycles where every ready warp waited for a collector unit
+  uint64_t n_simt_insts = 0;      // warp instructions counted by the SIMT statistics
+  uint64_t n_simt_active_lanes = 0; // their active threads
+  uint64_t n_branches = 0;        // conditional branches
+  uint64_t n_divergent_branches = 0; // branches taken by part of the active threads only
+  uint64_t n_simt_warps = 0;      // finished warps
+  double min_warp_simt_eff = 1.0; // lowest and highest SIMT efficiency of a finished warp
+  double max_warp_simt_eff = 0.0;
+  double sum_warp_simt_eff = 0.0; // summed over finished warps (unweighted average)
+  uint64_t n_warp_simt_eff[SIMT_EFF_BUCKETS] = {}; // finished warps per SIMT efficiency range
+  map<pair<int, uint64_t>, simt_pc_stats_s> m_simt_pc_stats; // by kernel and instruction address
+  uint64_t n_const_accesses = 0;  // constant cache accesses (one per warp load)
+  uint64_t n_const_hits = 0;      // of those, hits
+  uint64_t n_const_l2_hits = 0;   // misses served by L2
+  uint64_t n_local_loads = 0;     // local memory load and store accesses
+  uint64_t n_local_stores = 0;
+  uint64_t n_local_l1_hits = 0;   // their L1 hits
+  uint64_t n_cop_accesses[NUM_CACHE_OP_TYPES] = {};    // cache accesses per cache operator
+  uint64_t n_cop_l1_hits[NUM_CACHE_OP_TYPES] = {};     // their L1 hits
+  uint64_t n_cop_l1_bypasses[NUM_CACHE_OP_TYPES] = {}; // accesses served by L2 without allocating in L1
+  uint64_t n_l1_prefetches = 0;   // prefetches to L1 and to L2
+  uint64_t n_l2_prefetches = 0;
+  uint64_t n_redundant_prefetches = 0; // of those, lines already in the target cache (or in the L1 MSHR)
+  uint64_t n_dropped_prefetches = 0;   // L1 prefetch misses dropped for a full L1 MSHR
+  uint64_t n_tlb_dropped_prefetches = 0;  // prefetches dropped for an L1 TLB miss
+  uint64_t n_atomic_insts = 0;    // atomic warp instructions sent to the L2
+  uint64_t n_atomic_requests = 0; // their requests (one per line)
+  uint64_t n_atomic_ops = 0;      // thread operations
+  uint64_t n_atomic_l2_misses = 0; // requests whose line came from memory first
+  uint64_t n_atomic_contended = 0; // requests that waited for other operations on their line
+  uint64_t n_atomic_wait_cycles = 0; // cycles they waited
+  uint64_t n_atomic_latency = 0;  // request to response cycles, summed
+  uint64_t n_icache_accesses = 0; // instruction cache lookups (one per fetch)
+  uint64_t n_icache_misses = 0;   // of those, misses
+  uint64_t n_icache_l2_hits = 0;  // misses served by L2
+  uint64_t n_fetched_insts = 0;   // instructions moved into the instruction buffers
+  uint64_t n_fetch_stalls = 0;    // scheduler cycles where every ready warp had an empty instruction buffer
+  uint64_t n_l2_accesses = 0;     // L2 data accesses (loads, stores, fetches and atomics)
+  uint64_t n_l2_hits = 0;         // of those, hits
+  uint64_t n_energy_insts[NUM_FUNC_UNIT_TYPES + 1] = {}; // instructions committed per unit type (last: no unit)
+  uint64_t n_vta_lookups = 0;     // VTA lookups (cores running CCWS)
+  uint64_t n_dram_reads = 0;      // requests served by RAM
+  uint64_t n_dram_writes = 0;
 
   int n_blocks_total; 
   vector<int> n_blocks_per_kernel;
@@ -262,6 +576,40 @@ private:
 
   // scoreboard to track GPU requests on the fly
   vector<GPU_scoreboard_entry> GPU_scoreboard;
+
+  // L2 MSHR (Enable_MSHR): outstanding L2 misses by line, and misses waiting for a free entry
+  std::unordered_map<Addr, l2_mshr_entry_s> m_l2_mshr;
+  std::deque<RAM_request> m_l2_mshr_queue;
+
+  // L2 atomic unit (Enable_L2_Atomics): cycle each busy line finishes its queued operations, and
+  // responses by return cycle
+  std::unordered_map<Addr, sim_time_type> m_atomic_line_free;
+  std::multimap<sim_time_type, GPU_scoreboard_entry> m_atomic_responses;
+  std::unordered_map<Addr, atomic_line_stats_s> m_atomic_line_stats;
+
+  // Address translation (Enable_TLB): shared L2 TLB, page walk cache (upper page table levels) and
+  // cycle each page walker is free; translations in flight by page, and responses by return cycle
+  cache_c* l2_tlb = NULL;
+  cache_c* m_page_walk_cache = NULL;
+  std::vector<sim_time_type> m_walker_free_cycle;
+  int m_page_walk_levels = 0;
+  std::unordered_map<Addr, sim_time_type> m_tlb_walks;
+  std::multimap<sim_time_type, tlb_response_s> m_tlb_responses;
+  tlb_stats_s m_kernel_tlb_stats;   // current kernel
+  tlb_stats_s m_tlb_stats;          // whole run
+
+  // Unified memory (Enable_UVM): pages in device memory and the cycle their migration is done (the
+  // others are in host memory), faults by the cycle their walk raised them, translations waiting
+  // for a fault, and cycle the fault handler is free
+  std::unordered_map<Addr, sim_time_type> m_uvm_pages;
+  std::multimap<sim_time_type, Addr> m_uvm_faults;
+  std::unordered_map<Addr, std::vector<tlb_response_s>> m_uvm_waiters;
+  sim_time_type m_uvm_handler_free = 0;
+  uint64_t n_uvm_faults = 0;          // page faults (first access to a page in host memory)
+  uint64_t n_uvm_batches = 0;         // fault batches serviced
+  uint64_t n_uvm_migrated_pages = 0;  // pages moved to device memory
+  uint64_t n_uvm_prefetched_pages = 0; // of those, pages moved along with a faulting page
+  uint64_t n_uvm_batch_cycles = 0;    // cycles the fault handler was busy
   void read_trace(string trace_path, int truncate_size);
 
   int l2cache_size; 
@@ -0,0 +1,394 @@
+#include <chrono>
+#include <algorithm>
+
+#include "optimistic.h"
+#include "macsim.h"
+#include "core.h"
+#include "cache.h"
+
+using namespace std;
+
+#define ASSERTM(cond, args...)                                    \
+do {                                                              \
+  if (!(cond)) {                                                  \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, "%s\n", #cond);                               \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, ## args);                                     \
+    fprintf(stderr, "\n");                                        \
+    exit(15);                                                     \
+  }                                                               \
+} while (0)
+
+// Cycles at which macsim/main do periodic work (timeouts, progress) that must run serially
+#define OPT_SERIAL_PERIOD 100000
+
+// Smallest window worth speculating
+#define OPT_MIN_WINDOW 4
+
+// Polls of the window generation before an idle worker blocks (windows follow each other closely
+// while the cores run, but not during serial stretches or between kernels)
+#define OPT_SPIN_POLLS 4096
+
+static double elapsed_sec(chrono::steady_clock::time_point start) {
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+optimistic_c::optimistic_c(macsim* gpusim, RAM* ram, int n_threads, int max_window):
+  gpusim(gpusim), ram(ram), n_threads(n_threads)
+{
+  // A request issued inside the window must not complete inside it
+  this->max_window = std::min<int>(max_window, ram->get_latency());
+  this->max_window = std::max<int>(this->max_window, OPT_MIN_WINDOW);
+  cur_window = this->max_window;
+
+  abort_cycle.resize(gpusim->n_of_cores);
+  core_time.resize(gpusim->n_of_cores);
+  win_responses.resize(gpusim->n_of_cores);
+  speculating.resize(gpusim->n_of_cores);
+
+  // Thread 0 is the simulation thread itself
+  for (int tid = 1; tid < n_threads; tid++)
+    workers.push_back(thread(&optimistic_c::worker, this, tid));
+
+  gpusim->m_optimistic = this;
+  printf("Optimistic simulation: %d threads, window: %d cycles\n", n_threads, this->max_window);
+}
+
+optimistic_c::~optimistic_c() {
+  {
+    lock_guard<mutex> lock(park_mutex);
+    stopping = true;
+  }
+  park_cv.notify_all();
+  for (auto& t : workers)
+    t.join();
+  gpusim->m_optimistic = NULL;
+}
+
+bool optimistic_c::is_supported(GPU_Parameter_Set* gpu_params) {
+  // The shared L2 MSHR merges the misses of different cores, which speculative windows don't validate
+  if (gpu_params->Enable_MSHR)
+    return false;
+
+  // Instruction and constant cache misses, prefetches, streaming fills, translations and atomics are not
+  // logged for replay
+  if (gpu_params->Enable_ICache || gpu_params->Enable_Const_Cache || gpu_params->Enable_Cache_Operators ||
+      gpu_params->Enable_TLB || gpu_params->Enable_L2_Atomics)
+    return false;
+
+  // Windows replay RAM responses in core cycles
+  if (gpu_params->Enable_Clock_Domains)
+    return false;
+
+  // Logs would be printed out of order (and for rolled back cycles)
+#if defined(LOG_WARP_SCHEDULING) || defined(LOG_CCWS_WARP_SCHEDULING)
+  return false;
+#else
+  return !gpu_params->GPU_Cache_Log;
+#endif
+}
+
+void optimistic_c::worker(int tid) {
+  uint64_t seen = 0;
+  while (true) {
+    // Spin, then park until the next window
+    auto next_window = [&] { return generation.load(memory_order_acquire) != seen || stopping; };
+    for (int poll = 0; poll < OPT_SPIN_POLLS && !next_window(); poll++)
+      this_thread::yield();
+    if (!next_window()) {
+      unique_lock<mutex> lock(park_mutex);
+      park_cv.wait(lock, next_window);
+    }
+    uint64_t gen = generation.load(memory_order_acquire);
+    if (gen == seen) return;  // stopping
+    seen = gen;
+
+    for (int core_id = tid; core_id < gpusim->n_of_cores; core_id += n_threads)
+      if (speculating[core_id]) speculate(core_id);
+
+    n_done.fetch_add(1, memory_order_acq_rel);
+  }
+}
+
+void optimistic_c::speculate(int core_id) {
+  auto start = chrono::steady_clock::now();
+  core_c* core = gpusim->core_pointers_v[core_id];
+  vector<spec_response_s>& responses = win_responses[core_id];
+
+  core->save_checkpoint();
+  core->c_speculative = true;
+  core->c_l1cache->set_clock(&core->c_cache_clock);
+
+  size_t resp_idx = 0;
+  for (sim_time_type t = win_start + 1; t <= win_end; t++) {
+    core->c_spec_cycle = t;
+    core->c_cache_clock = clock_at(t);
+    core->run_a_cycle();
+    if (core->c_spec_aborted) {
+      abort_cycle[core_id] = t;
+      break;
+    }
+
+    // Responses returned at the end of cycle t (see macsim::get_mem_response)
+    for (; resp_idx < responses.size() && responses[resp_idx].cycle == t; resp_idx++) {
+      if (responses[resp_idx].insert_in_l1)
+        core->repair_l1_miss(responses[resp_idx].addr, responses[resp_idx].slot_id);
+      core->c_memory_responses.push({responses[resp_idx].slot_id, responses[resp_idx].dst_reg,
+                                     responses[resp_idx].addr, responses[resp_idx].insert_in_l1});
+    }
+  }
+
+  core->c_speculative = false;
+  core->c_l1cache->set_clock(NULL);
+  core_time[core_id] = elapsed_sec(start);
+}
+
+bool optimistic_c::run_window(sim_time_type max_cycle) {
+  macsim* gpu = gpusim;
+  if (gpu->gpu_retired || gpu->kernel_starting || gpu->kernel_ending)
+    return true;
+
+  // Pick the window: periodic checks and the last cycle before max_cycle are simulated serially
+  win_start = gpu->m_cycle;
+  win_end = win_start + cur_window;
+  win_end = std::min(win_end, (win_start / OPT_SERIAL_PERIOD + 1) * OPT_SERIAL_PERIOD - 1);
+  if (max_cycle > 0)
+    win_end = std::min(win_end, max_cycle - 1);
+  if (win_end < win_start + OPT_MIN_WINDOW)
+    return true;
+  n_windows++;
+
+  // Run RAM ahead: everything it returns up to the end of the window was requested before it.
+  // RAM may already be further ahead after a rollback; later responses stay queued.
+  ram->run_until(win_end - 1);
+  vector<RAM_response> responses;
+  while (!gpu->gpu_mem_response_queue->empty() && gpu->gpu_mem_response_queue->front().resp_time < win_end) {
+    responses.push_back(gpu->gpu_mem_response_queue->front());
+    gpu->gpu_mem_response_queue->pop();
+  }
+
+  unordered_map<uint64_t, GPU_scoreboard_entry*> sb_index;
+  for (auto& entry : gpu->GPU_scoreboard)
+    sb_index[entry.mem_queue_id] = &entry;
+
+  for (int core_id = 0; core_id < gpu->n_of_cores; core_id++) {
+    win_responses[core_id].clear();
+    abort_cycle[core_id] = 0;
+    core_time[core_id] = 0;
+    speculating[core_id] = !gpu->core_pointers_v[core_id]->is_retired();
+  }
+  for (auto& resp : responses) {
+    auto it = sb_index.find(resp.request_id);
+    if (it == sb_index.end()) continue;
+    // The scoreboard entry is the reference for the requester, as in macsim::get_mem_response
+    ASSERTM(it->second->core_id == resp.core_id && it->second->slot_id == resp.slot_id,
+            "Response %lu: core %d slot %d, scoreboard entry: core %d slot %d\n", (unsigned long)resp.request_id,
+            resp.core_id, resp.slot_id, it->second->core_id, it->second->slot_id);
+    spec_response_s sresp = {std::max(win_start + 1, resp.resp_time + 1), it->second->slot_id, it->second->dst_reg,
+                             it->second->addr, it->second->insert_in_l1};
+    win_responses[it->second->core_id].push_back(sresp);
+  }
+
+  // Replacement timestamps follow core 0's cycle (see cache.cpp)
+  core_c* core0 = gpu->core_pointers_v[0];
+  clock_base = core0->get_cycle();
+  clock_running = !core0->is_retired();
+
+  // Speculate in parallel
+  auto wall_start = chrono::steady_clock::now();
+  n_done.store(0, memory_order_release);
+  {
+    lock_guard<mutex> lock(park_mutex);
+    generation.fetch_add(1, memory_order_acq_rel);
+  }
+  park_cv.notify_all();
+  for (int core_id = 0; core_id < gpu->n_of_cores; core_id += n_threads)
+    if (speculating[core_id]) speculate(core_id);
+  while (n_done.load(memory_order_acquire) != n_threads - 1)
+    this_thread::yield();
+  double wall_time = elapsed_sec(wall_start);
+
+  // First cycle in which some core's view was wrong or incomplete
+  sim_time_type stop_cycle = 0;
+  for (int core_id = 0; core_id < gpu->n_of_cores; core_id++)
+    if (abort_cycle[core_id] && (!stop_cycle || abort_cycle[core_id] < stop_cycle))
+      stop_cycle = abort_cycle[core_id];
+
+  if (stop_cycle) {
+    n_aborts++;
+    return rollback(stop_cycle, responses, false);
+  }
+
+  vector<deferred_req_s> requests;
+  stop_cycle = validate(responses, sb_index, requests);
+  if (stop_cycle) {
+    n_violations++;
+    return rollback(stop_cycle, responses, true);
+  }
+
+  // Commit: the L2 is up to date, apply memory requests and responses in serial order
+  gpu->l2cache->end_journal();
+  gpu->n_l2_accesses += win_l2_accesses;
+  gpu->n_l2_hits += win_l2_hits;
+  size_t resp_idx = 0;
+  for (sim_time_type t = win_start + 1; t <= win_end; t++) {
+    gpu->m_cycle = t;
+    for (; resp_idx < responses.size() && std::max(win_start + 1, responses[resp_idx].resp_time + 1) == t; resp_idx++) {
+      RAM_response& resp = responses[resp_idx];
+      gpu->n_responses++;
+      sim_time_type req_time = 0, resp_time = 0;
+      for (auto entry = gpu->GPU_scoreboard.begin(); entry != gpu->GPU_scoreboard.end(); entry++) {
+        if (entry->mem_queue_id == resp.request_id) {
+          req_time = entry->req_time;
+          resp_time = t - req_time;
+
+          // Cores that were not speculating (retired) still get the response
+          if (!speculating[entry->core_id]) {
+            if (entry->insert_in_l1)
+              gpu->core_pointers_v[entry->core_id]->repair_l1_miss(entry->addr, entry->slot_id);
+            gpu->core_pointers_v[entry->core_id]->c_memory_responses.push({entry->slot_id, entry->dst_reg, entry->addr,
+                                                                           entry->insert_in_l1});
+          }
+          gpu->GPU_scoreboard.erase(entry);
+          break;
+        }
+      }
+      gpu->total_latency += resp_time;
+
+      if (resp.request_id % 1000 == 0)
+        MA_DEBUG2("RAM resp id:" << resp.request_id << " m_cycle=" << t << " req_time="
+        << req_time << " resp_time=" << resp_time << " total_latency=" << gpu->total_latency);
+    }
+  }
+  for (auto& req : requests) {
+    gpu->m_cycle = req.cycle;
+    if (req.event) {
+      spec_event_s* e = req.event;
+      gpu->inst_event(e->trace_info, e->addr, e->access_sz, req.core_id, e->block_id, e->warp_id, e->slot_id, req.cycle, e->insert_in_l1, e->mark_dirty);
+    } else {
+      gpu->send_writeback(req.writeback_addr);
+    }
+  }
+  gpu->m_cycle = win_end;
+  ram->requests_sent(win_end);
+  ram->run_until(win_end);
+
+  double core_time_total = 0;
+  for (int core_id = 0; core_id < gpu->n_of_cores; core_id++) {
+    if (!speculating[core_id]) continue;
+    core_c* core = gpu->core_pointers_v[core_id];
+    gpu->n_cache_req += core->c_spec_n_cache_req;
+    gpu->n_l1_hits += core->c_spec_n_l1_hits;
+    core->commit_checkpoint();
+    core_time_total += core_time[core_id];
+  }
+
+  n_committed++;
+  n_spec_cycles += win_end - win_start;
+  spec_core_time += core_time_total;
+  spec_wall_time += wall_time;
+  cur_window = std::min(cur_window * 2, max_window);
+  return true;
+}
+
+sim_time_type optimistic_c::validate(vector<RAM_response>& responses,
+                                     unordered_map<uint64_t, GPU_scoreboard_entry*>& sb_index,
+                                     vector<deferred_req_s>& requests) {
+  macsim* gpu = gpusim;
+  cache_c* l2 = gpu->l2cache;
+  sim_time_type l2_clock;
+  vector<size_t> log_idx(gpu->n_of_cores, 0);
+  size_t resp_idx = 0;
+
+  win_l2_accesses = win_l2_hits = 0;
+  l2->begin_journal();
+  l2->set_clock(&l2_clock);
+  for (sim_time_type t = win_start + 1; t <= win_end; t++) {
+    l2_clock = clock_at(t);
+
+    // Cores in order
+    for (int core_id = 0; core_id < gpu->n_of_cores; core_id++) {
+      if (!speculating[core_id]) continue;
+      vector<spec_event_s>& log = gpu->core_pointers_v[core_id]->c_spec_log;
+      for (size_t& i = log_idx[core_id]; i < log.size() && log[i].cycle == t; i++) {
+        spec_event_s& event = log[i];
+        if (event.is_mem_req) {
+          deferred_req_s req = {t, core_id, &event, 0};
+          requests.push_back(req);
+          continue;
+        }
+
+        Addr line_addr;
+        cache_data_t* data = (cache_data_t*) l2->access_cache(event.addr, &line_addr, true, 0);
+        if ((data != NULL) != event.l2_hit) {
+          l2->set_clock(NULL);
+          return t;
+        }
+        win_l2_accesses++;
+        win_l2_hits += data != NULL;
+        if (data && event.is_write)
+          data->m_dirty = true;
+      }
+    }
+
+    // Then memory responses (see macsim::get_mem_response)
+    for (; resp_idx < responses.size() && std::max(win_start + 1, responses[resp_idx].resp_time + 1) == t; resp_idx++) {
+      auto it = sb_index.find(responses[resp_idx].request_id);
+      if (it == sb_index.end()) continue;
+      Addr victim_line_addr;
+      if (gpu->fill_l2(it->second->addr, it->second->mark_dirty, &victim_line_addr)) {
+        deferred_req_s req = {t, -1, NULL, victim_line_addr};
+        requests.push_back(req);
+      }
+    }
+  }
+  l2->set_clock(NULL);
+  return 0;
+}
+
+bool optimistic_c::rollback(sim_time_type cycle, vector<RAM_response>& responses, bool l2_journaled) {
+  macsim* gpu = gpusim;
+  if (l2_journaled)
+    gpu->l2cache->rollback_journal();
+
+  for (int core_id = 0; core_id < gpu->n_of_cores; core_id++)
+    if (speculating[core_id])
+      gpu->core_pointers_v[core_id]->restore_checkpoint();
+
+  // Put responses back in front of the ones RAM produced further ahead; RAM stays ahead
+  queue<RAM_response> later;
+  swap(later, *gpu->gpu_mem_response_queue);
+  for (auto& resp : responses)
+    gpu->gpu_mem_response_queue->push(resp);
+  for (; !later.empty(); later.pop())
+    gpu->gpu_mem_response_queue->push(later.front());
+
+  cur_window = std::max(cur_window / 2, OPT_MIN_WINDOW);
+
+  // Re-run serially up to (and including) the cycle that went wrong
+  while (gpu->m_cycle < cycle) {
+    if (!gpu->run_a_cycle())
+      return false;
+    ram->requests_sent(gpu->m_cycle);
+    ram->run_until(gpu->m_cycle);
+    n_replay_cycles++;
+  }
+  return true;
+}
+
+void optimistic_c::print_stats() {
+  uint64_t n_rollbacks = n_violations + n_aborts;
+  printf("Optimistic:\n");
+  printf("\tOPT_NUM_THREADS         : %d\n", n_threads);
+  printf("\tOPT_NUM_WINDOWS         : %lu\n", n_windows);
+  printf("\tOPT_COMMITTED_WINDOWS   : %lu\n", n_committed);
+  printf("\tOPT_L2_ROLLBACKS        : %lu\n", n_violations);
+  printf("\tOPT_ABORT_ROLLBACKS     : %lu\n", n_aborts);
+  printf("\tOPT_ROLLBACK_RATE_PERC  : %.2f\n", n_windows ? (float)n_rollbacks * 100.0 / (float)n_windows : 0.0);
+  printf("\tOPT_SPECULATED_CYCLES   : %lu\n", n_spec_cycles);
+  printf("\tOPT_REPLAYED_CYCLES     : %lu\n", n_replay_cycles);
+  // Cores simulated in parallel during committed windows (not a speedup over serial simulation: validation,
+  // commit and serial re-runs are not counted)
+  printf("\tOPT_SPEC_PARALLELISM    : %.2f\n", spec_wall_time > 0 ? spec_core_time / spec_wall_time : 0.0);
+}
@@ -0,0 +1,229 @@
+#ifndef OPTIMISTIC_H
+#define OPTIMISTIC_H
+
+#include <vector>
+#include <queue>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include "sim_defs.h"
+#include "trace.h"
+#include "macsim.h"
+#include "ccws_vta.h"
+#include "ram.h"
+#include "warp_slots.h"
+
+class core_c;
+
+// Shared-state access made by a core while speculating
+struct spec_event_s {
+  sim_time_type cycle;
+  bool is_mem_req;                          // false: L2 access, true: memory request
+  Addr addr;                                // L2 access address, memory request address
+  bool is_write;                            // L2 access is a write (marks line dirty on hit)
+  bool l2_hit;                              // L2 hit/miss observed while speculating
+  trace_info_nvbit_small_s* trace_info;     // Memory request: instruction
+  int access_sz;                            // Memory request: size
+  int block_id;                             // Memory request: block of the issuing warp
+  int warp_id;                              // Memory request: issuing warp
+  int slot_id;                              // Memory request: warp slot of the issuing warp
+  bool insert_in_l1;                        // Memory request: insert block in l1 when response returns
+  bool mark_dirty;                          // Memory request: mark L2 line dirty when response returns
+};
+
+// Memory request or L2 writeback applied when a window commits (event == NULL: writeback)
+struct deferred_req_s {
+  sim_time_type cycle;
+  int core_id;
+  spec_event_s* event;
+  Addr writeback_addr;
+};
+
+// Memory response delivered to a core while speculating
+struct spec_response_s {
+  sim_time_type cycle;
+  int slot_id;
+  int dst_reg;
+  Addr addr;
+  bool insert_in_l1;
+};
+
+// Warp state at the start of a speculative window
+struct warp_checkpoint_s {
+  warp_s* warp;
+  int ccws_lls_score;
+  ccws_vta vta;
+  std::deque<trace_info_nvbit_small_s*> trace_buffer;
+  std::deque<trace_info_nvbit_small_s*> trace_replay_buffer;
+  std::vector<sim_time_type> reg_ready_cycle;
+  int n_mem_pending;
+  std::vector<pending_load_s> pending_loads;
+  int barrier_id;
+  sim_time_type barrier_wait_start;
+  uint64_t simt_insts;
+  uint64_t simt_active_lanes;
+};
+
+// Barrier state of a block on the core
+struct block_checkpoint_s {
+  block_schedule_info_s* block;
+  block_barrier_s barriers[MAX_BLOCK_BARRIERS];
+};
+
+// Members of core_c saved at the start of a speculative window and restored on rollback: the
+// checkpoint, core_c::save_checkpoint and core_c::restore_checkpoint are all generated from these
+// lists. A member added to core_c that a cycle can change (counters, free cycles, queues) must be
+// listed here; configuration and pointers set at construction need not be. A missing member shows
+// up as stats that differ between optimistic and serial runs.
+#define CORE_CHECKPOINT_FIELDS(X)                                     \
+  X(sim_time_type, c_cycle)                                           \
+  X(sim_time_type, stall_cycles)                                      \
+  X(uint64_t, inst_count_total)                                       \
+  X(uint64_t, num_vta_hits)                                           \
+  X(bool, c_retire)                                                   \
+  X(bool, c_has_work)                                                 \
+  X(sim_time_type, c_idle_cycles)                                     \
+  X(uint64_t, c_dep_stalls)                                           \
+  X(uint64_t, c_load_use_stalls)                                      \
+  X(uint64_t, c_coalescer_insts)                                      \
+  X(uint64_t, c_coalescer_units)                                      \
+  X(uint64_t, c_barriers_released)                                    \
+  X(uint64_t, c_barrier_waits)                                        \
+  X(uint64_t, c_barrier_wait_cycles)                                  \
+  X(sim_time_type, c_ldst_free_cycle)                                 \
+  X(uint64_t, c_ldst_stalls)                                          \
+  X(uint64_t, c_shmem_insts)                                          \
+  X(uint64_t, c_shmem_conflict_insts)                                 \
+  X(uint64_t, c_shmem_wavefronts)                                     \
+  X(uint64_t, c_shmem_conflict_cycles)                                \
+  X(std::vector<std::vector<sim_time_type>>, c_fu_free_cycle)         \
+  X(std::vector<std::vector<sim_time_type>>, c_rf_port_free_cycle)    \
+  X(std::vector<sim_time_type>, c_oc_free_cycle)                      \
+  X(uint64_t, c_rf_reads)                                             \
+  X(uint64_t, c_rf_conflict_reads)                                    \
+  X(uint64_t, c_rf_conflict_cycles)                                   \
+  X(uint64_t, c_oc_stalls)                                            \
+  X(uint64_t, c_local_loads)                                          \
+  X(uint64_t, c_local_stores)                                         \
+  X(uint64_t, c_local_l1_hits)                                        \
+  X(uint64_t, c_simt_insts)                                           \
+  X(uint64_t, c_simt_active_lanes)                                    \
+  X(uint64_t, c_branches)                                             \
+  X(uint64_t, c_divergent_branches)                                   \
+  X(uint64_t, c_vta_lookups)                                          \
+  X(std::vector<int>, c_gto_last_warp_id)                             \
+  X(std::queue<core_mem_response_s>, c_memory_responses)              \
+  X(warp_slots_c, c_warp_slots)                                       \
+  X(std::vector<warp_s*>, c_sched_running_warps)
+
+// Array members: type, name, number of elements
+#define CORE_CHECKPOINT_ARRAYS(X)                                     \
+  X(uint64_t, c_fu_issued, NUM_FUNC_UNIT_TYPES)                       \
+  X(uint64_t, c_fu_stalls, NUM_FUNC_UNIT_TYPES)                       \
+  X(uint64_t, c_energy_insts, NUM_FUNC_UNIT_TYPES + 1)
+
+// Core state at the start of a speculative window (L1 is rolled back with its journal)
+struct core_checkpoint_s {
+#define CORE_CHECKPOINT_FIELD(type, name) type name;
+#define CORE_CHECKPOINT_ARRAY(type, name, n) type name[n];
+  CORE_CHECKPOINT_FIELDS(CORE_CHECKPOINT_FIELD)
+  CORE_CHECKPOINT_ARRAYS(CORE_CHECKPOINT_ARRAY)
+#undef CORE_CHECKPOINT_FIELD
+#undef CORE_CHECKPOINT_ARRAY
+  std::vector<warp_checkpoint_s> warps;
+  std::vector<block_checkpoint_s> barriers;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// Optimistic (Time Warp style) parallel simulation
+///
+/// Cores run a window of cycles ahead in parallel against the L2 as it was at the start of
+/// the window. L2 accesses and memory requests are logged instead of being applied. The logs
+/// are then replayed on the real L2 in serial order (cycle, core id); if any L2 lookup gives a
+/// different result than the core observed, or a core reached an irrevocable action (block
+/// dispatch, end of a warp's trace, retirement), all cores roll back to their checkpoints and
+/// the window is re-run serially up to that cycle. Results are identical to serial simulation.
+///
+/// Memory responses are known in advance: RAM runs ahead of the cores by up to its latency,
+/// since no request issued inside the window can complete inside it.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class optimistic_c {
+public:
+  // Create the driver and its worker threads
+  optimistic_c(macsim* gpusim, RAM* ram, int n_threads, int max_window);
+
+  // Stop worker threads
+  ~optimistic_c();
+
+  // Can the current configuration run optimistically?
+  static bool is_supported(GPU_Parameter_Set* gpu_params);
+
+  // Advance the simulation by up to one window, staying below max_cycle. Returns false once
+  // the GPU retired.
+  bool run_window(sim_time_type max_cycle);
+
+  // Print rollback and speedup stats
+  void print_stats();
+
+private:
+  macsim* gpusim;
+  RAM* ram;
+  int n_threads;
+  int max_window;
+  int cur_window;
+
+  // Window being speculated
+  sim_time_type win_start;                            // Last committed cycle
+  sim_time_type win_end;                              // Last cycle of the window
+  sim_time_type clock_base;                           // Cache replacement clock at win_start
+  bool clock_running;                                 // Does the clock advance (core 0 active)?
+  std::vector<std::vector<spec_response_s>> win_responses;   // Responses per core
+  uint64_t win_l2_accesses = 0;       // L2 accesses replayed by validate(), counted on commit
+  uint64_t win_l2_hits = 0;
+  std::vector<sim_time_type> abort_cycle;             // Per core, 0 if not aborted
+  std::vector<double> core_time;                      // Per core busy time in the window (s)
+  std::vector<char> speculating;                      // Per core, active in this window
+
+  // Worker threads (spin on generation for back-to-back windows, then park on park_cv)
+  std::vector<std::thread> workers;
+  std::atomic<uint64_t> generation{0};
+  std::atomic<int> n_done{0};
+  std::atomic<bool> stopping{false};
+  std::mutex park_mutex;                  // Guards generation and stopping updates for parked workers
+  std::condition_variable park_cv;
+
+  // Stats
+  uint64_t n_windows = 0;
+  uint64_t n_committed = 0;
+  uint64_t n_violations = 0;          // Rollbacks due to L2 causality violations
+  uint64_t n_aborts = 0;              // Rollbacks due to irrevocable actions
+  uint64_t n_spec_cycles = 0;         // Cycles committed from speculation
+  uint64_t n_replay_cycles = 0;       // Cycles re-run serially after a rollback
+  double spec_core_time = 0;          // Core busy time summed over committed windows (s)
+  double spec_wall_time = 0;          // Wall time of committed speculative phases (s)
+
+  // Cache replacement clock in cycle t
+  sim_time_type clock_at(sim_time_type t) {
+    return clock_running ? clock_base + (t - win_start) : clock_base;
+  }
+
+  // Worker thread loop
+  void worker(int tid);
+
+  // Speculatively run the window on one core
+  void speculate(int core_id);
+
+  // Replay logs on the real L2, returns the first violating cycle (0 if none)
+  sim_time_type validate(std::vector<RAM_response>& responses,
+                         std::unordered_map<uint64_t, GPU_scoreboard_entry*>& sb_index,
+                         std::vector<deferred_req_s>& requests);
+
+  // Roll back all cores (and the L2) and rerun serially up to cycle; returns false if the GPU retired
+  bool rollback(sim_time_type cycle, std::vector<RAM_response>& responses, bool l2_journaled);
+};
+
+#endif // OPTIMISTIC_H
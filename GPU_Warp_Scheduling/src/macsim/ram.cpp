@@ -8,10 +8,16 @@ void RAM::run_a_cycle(){
         // return responses if t_request + latency is reached
         if (ncycles > req.req_time + latency){
             request_queue_ptr->pop();
+            if (req.is_store)
+                n_writes++;
+            else
+                n_reads++;
             RAM_response resp = {
                 .request_id = req.request_id,
                 .core_id = req.core_id,
-                .warp_id = req.warp_id
+                .warp_id = req.warp_id,
+                .slot_id = req.slot_id,
+                .resp_time = ncycles + 1
             };
             response_queue_ptr->push(resp);
         }
@@ -19,6 +25,129 @@ void RAM::run_a_cycle(){
     ncycles++;
 }
 
+void RAM::run_until(sim_time_type cycle){
+    if (!threaded) {
+        while(ncycles < cycle)
+            run_a_cycle();
+        return;
+    }
+
+    flush_requests();
+    if (target_cycle.load(std::memory_order_relaxed) < cycle)
+        target_cycle.store(cycle, std::memory_order_release);
+
+    // Responses of every cycle up to done are in the ring once done is published
+    while (true) {
+        sim_time_type done = done_cycle.load(std::memory_order_acquire);
+        RAM_response resp;
+        while (response_ring.pop(resp))
+            gpu_response_queue_ptr->push(resp);
+        if (done >= cycle)
+            break;
+        std::this_thread::yield();
+    }
+}
+
+void RAM::requests_sent(sim_time_type cycle){
+    if (!threaded)
+        return;
+    flush_requests();
+    sent_cycle.store(cycle, std::memory_order_release);
+}
+
+void RAM::flush_requests(){
+    while (!gpu_request_queue_ptr->empty()) {
+        // The RAM thread drains the ring even when it can't run ahead
+        while (!request_ring.push(gpu_request_queue_ptr->front()))
+            std::this_thread::yield();
+        gpu_request_queue_ptr->pop();
+    }
+}
+
+void RAM::start_thread(sim_time_type max_skew){
+    if (threaded)
+        return;
+
+    // A request sent at cycle t is popped at RAM cycle t + latency + 1 at the earliest
+    this->max_skew = max_skew < latency ? max_skew : latency;
+    gpu_request_queue_ptr = request_queue_ptr;
+    gpu_response_queue_ptr = response_queue_ptr;
+    request_queue_ptr = &thread_request_queue;
+    response_queue_ptr = &thread_response_queue;
+
+    // RAM may already have run ahead (and queued requests) in lockstep mode
+    while (!gpu_request_queue_ptr->empty()) {
+        thread_request_queue.push(gpu_request_queue_ptr->front());
+        gpu_request_queue_ptr->pop();
+    }
+    sent_cycle = ncycles;
+    target_cycle = ncycles;
+    done_cycle = ncycles;
+    stopping = false;
+    threaded = true;
+    ram_thread = std::thread(&RAM::thread_loop, this);
+}
+
+void RAM::stop_thread(){
+    if (!threaded)
+        return;
+    stopping = true;
+    ram_thread.join();
+    threaded = false;
+
+    // Back to lockstep: hand everything over to the GPU side queues
+    RAM_request req;
+    while (request_ring.pop(req))
+        thread_request_queue.push(req);
+    for (; !thread_request_queue.empty(); thread_request_queue.pop())
+        gpu_request_queue_ptr->push(thread_request_queue.front());
+    RAM_response resp;
+    while (response_ring.pop(resp))
+        gpu_response_queue_ptr->push(resp);
+    for (; !thread_response_queue.empty(); thread_response_queue.pop())
+        gpu_response_queue_ptr->push(thread_response_queue.front());
+    request_queue_ptr = gpu_request_queue_ptr;
+    response_queue_ptr = gpu_response_queue_ptr;
+}
+
+void RAM::thread_loop(){
+    while (!stopping) {
+        // Read the bounds first: every request they depend on is in the ring by then
+        sim_time_type limit = sent_cycle.load(std::memory_order_acquire) + max_skew;
+        sim_time_type target = target_cycle.load(std::memory_order_acquire);
+        if (target > limit)
+            limit = target;
+
+        RAM_request req;
+        while (request_ring.pop(req))
+            thread_request_queue.push(req);
+
+        bool progress = false;
+        while (ncycles < limit) {
+            run_a_cycle();
+            progress = true;
+
+            // Cycle is done once all its responses are handed over; stop if the ring is full
+            while (!thread_response_queue.empty() && response_ring.push(thread_response_queue.front()))
+                thread_response_queue.pop();
+            if (!thread_response_queue.empty())
+                break;
+            done_cycle.store(ncycles, std::memory_order_release);
+        }
+
+        // Retry a full response ring
+        if (!thread_response_queue.empty()) {
+            while (!thread_response_queue.empty() && response_ring.push(thread_response_queue.front()))
+                thread_response_queue.pop();
+            if (thread_response_queue.empty())
+                done_cycle.store(ncycles, std::memory_order_release);
+        }
+
+        if (!progress)
+            std::this_thread::yield();
+    }
+}
+
 void RAM::set_queues(queue<RAM_request>* req_queue_ptr, queue<RAM_response>* resp_queue_ptr) {
     request_queue_ptr = req_queue_ptr;
     response_queue_ptr = resp_queue_ptr;
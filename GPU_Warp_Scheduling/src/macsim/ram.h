@@ -3,7 +3,10 @@
 
 #include <stdint.h>
 #include <queue>
+#include <atomic>
+#include <thread>
 #include "sim_defs.h"
+#include "spsc_ring.h"
 
 using namespace std;
 
@@ -15,6 +18,7 @@ struct RAM_request
     sim_time_type req_time;
     int core_id;
     int warp_id;
+    int slot_id;
     uint64_t request_id;
 };
 
@@ -23,6 +27,8 @@ struct RAM_response
     uint64_t request_id;
     int core_id;
     int warp_id;
+    int slot_id;
+    sim_time_type resp_time;    // RAM cycle that produced the response
 };
 
 class RAM {
@@ -30,11 +36,36 @@ class RAM {
     RAM(uint64_t latency=200):
         latency(latency)
     {}
-    ~RAM(){}
+    ~RAM(){ stop_thread(); }
 
     // Run a cycle
     void run_a_cycle();
 
+    // Run cycles until `cycle` cycles have elapsed (no-op if RAM is already there).
+    // On a RAM thread: wait until it got there and collect its responses.
+    void run_until(sim_time_type cycle);
+
+    // All requests up to (and including) `cycle` have been queued. A RAM thread may run
+    // ahead of it by up to its skew.
+    void requests_sent(sim_time_type cycle);
+
+    // Run RAM on its own thread, at most max_skew cycles ahead of the sent requests
+    // (capped to the latency, so no request can be missed)
+    void start_thread(sim_time_type max_skew);
+
+    // Stop the RAM thread
+    void stop_thread();
+
+    // Get number of cycles elapsed
+    sim_time_type get_cycle() { return ncycles; }
+
+    // Get access latency
+    uint64_t get_latency() { return latency; }
+
+    // Get number of reads and writes served
+    uint64_t get_n_reads() { return n_reads; }
+    uint64_t get_n_writes() { return n_writes; }
+
     // setup request and response queues
     void set_queues(queue<RAM_request>* req_queue_ptr, queue<RAM_response>* resp_queue_ptr);
 
@@ -43,6 +74,30 @@ class RAM {
     queue<RAM_response>* response_queue_ptr;
     uint64_t ncycles = 0;
     uint64_t latency;
+    uint64_t n_reads = 0;
+    uint64_t n_writes = 0;
+
+    // RAM thread: the queues set with set_queues() stay on the GPU side, RAM uses its own
+    // queues and the two sides exchange requests/responses over the rings
+    bool threaded = false;
+    std::thread ram_thread;
+    queue<RAM_request>* gpu_request_queue_ptr;
+    queue<RAM_response>* gpu_response_queue_ptr;
+    queue<RAM_request> thread_request_queue;
+    queue<RAM_response> thread_response_queue;
+    spsc_ring<RAM_request> request_ring;
+    spsc_ring<RAM_response> response_ring;
+    sim_time_type max_skew = 0;
+    std::atomic<sim_time_type> sent_cycle{0};      // GPU side: last cycle whose requests are in the ring
+    std::atomic<sim_time_type> target_cycle{0};    // GPU side: cycle RAM was asked to reach
+    std::atomic<sim_time_type> done_cycle{0};      // RAM side: cycles run (responses are in the ring)
+    std::atomic<bool> stopping{false};
+
+    // RAM thread loop
+    void thread_loop();
+
+    // GPU side: move queued requests into the request ring
+    void flush_requests();
 };
 
 #endif // RAM_H
\ No newline at end of file
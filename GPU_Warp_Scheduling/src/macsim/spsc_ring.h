@@ -0,0 +1,50 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread
+template <typename T>
+class spsc_ring {
+    public:
+    // capacity is rounded up to a power of two
+    spsc_ring(size_t capacity=4096) {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    // Producer: returns false if the ring is full
+    bool push(const T& item) {
+        size_t tail = tail_idx.load(std::memory_order_relaxed);
+        if (tail - head_idx.load(std::memory_order_acquire) == buffer.size())
+            return false;
+        buffer[tail & mask] = item;
+        tail_idx.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: returns false if the ring is empty
+    bool pop(T& item) {
+        size_t head = head_idx.load(std::memory_order_relaxed);
+        if (head == tail_idx.load(std::memory_order_acquire))
+            return false;
+        item = buffer[head & mask];
+        head_idx.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    private:
+    std::vector<T> buffer;
+    size_t mask;
+
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<size_t> head_idx{0};
+    alignas(64) std::atomic<size_t> tail_idx{0};
+};
+
+#endif // SPSC_RING_H
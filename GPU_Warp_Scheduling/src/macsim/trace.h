@@ -414,4 +414,183 @@ inline bool is_using_shared_memory(uint8_t opcode){
   return (it != end(SHARED_MEM_LIST));
 }
 
+// Memory space of an access (m_addr_space, NVBit's InstrType::MemorySpace)
+enum class Mem_Space_Types {
+  NONE = 0,     // Not recorded by the tracer
+  LOCAL,
+  GENERIC,
+  GLOBAL,
+  SHARED,
+  CONSTANT,
+  GLOBAL_TO_SHARED,
+  SURFACE,
+  TEXTURE,
+};
+
+// Memory space of a memory instruction: the traced one, or the one its opcode implies
+inline Mem_Space_Types get_mem_space(const trace_info_nvbit_small_s* trace_info){
+  if (trace_info->m_addr_space != (uint8_t)Mem_Space_Types::NONE)
+    return (Mem_Space_Types)trace_info->m_addr_space;
+  switch (trace_info->m_opcode) {
+    case LDC: return Mem_Space_Types::CONSTANT;
+    case LDL: case STL: return Mem_Space_Types::LOCAL;
+    case LDS: case LDSM: case STS: case ATOMS: return Mem_Space_Types::SHARED;
+    default: return Mem_Space_Types::GLOBAL;
+  }
+}
+
+// Cache operator of a load or store (m_cache_operator, the PTX ld/st cache hint)
+enum class Cache_Op_Types {
+  NONE = 0,     // Not recorded: the default of the instruction (.ca for loads, .wb for stores)
+  CA,           // Cache at all levels
+  CG,           // Cache in L2 only (global)
+  CS,           // Streaming: evict first
+  LU,           // Last use
+  CV,           // Volatile: fetch again
+  WB,           // Write back
+  WT,           // Write through
+  NUM,
+};
+
+constexpr const char* Cache_Op_Types_str[] = {
+  "NONE",
+  "CA",
+  "CG",
+  "CS",
+  "LU",
+  "CV",
+  "WB",
+  "WT"
+};
+
+#define NUM_CACHE_OP_TYPES ((int)Cache_Op_Types::NUM)
+
+inline Cache_Op_Types get_cache_op(const trace_info_nvbit_small_s* trace_info){
+  if (trace_info->m_cache_operator >= NUM_CACHE_OP_TYPES)
+    return Cache_Op_Types::NONE;
+  return (Cache_Op_Types)trace_info->m_cache_operator;
+}
+
+// Cache level a prefetch (CCTL) brings its line to (m_cache_level)
+enum class Cache_Level_Types {
+  NONE = 0,
+  L1,
+  L2,
+};
+
+inline bool is_prefetch(const trace_info_nvbit_small_s* trace_info){
+  return trace_info->m_opcode == CCTL &&
+         (trace_info->m_cache_level == (uint8_t)Cache_Level_Types::L1 ||
+          trace_info->m_cache_level == (uint8_t)Cache_Level_Types::L2);
+}
+
+// Global memory atomics and reductions (executed at the L2 with Enable_L2_Atomics)
+inline bool is_global_atomic(uint8_t opcode){
+  return opcode == ATOM || opcode == ATOMG || opcode == RED;
+}
+
+// Execution unit of an opcode: selects its result latency (see macsim::init_opcode_latency)
+enum class Exec_Unit_Types {
+  INT = 0,
+  IMAD,
+  FP32,
+  FP16,
+  FP64,
+  SFU,
+  TENSOR,
+  CONV,
+  SHARED_MEM,
+  MEM,
+  MISC,
+};
+
+constexpr const char* Exec_Unit_Types_str[] = {
+  "INT",
+  "IMAD",
+  "FP32",
+  "FP16",
+  "FP64",
+  "SFU",
+  "TENSOR",
+  "CONV",
+  "SHARED_MEM",
+  "MEM",
+  "MISC"
+};
+
+inline Exec_Unit_Types get_exec_unit(uint8_t opcode){
+  switch (opcode) {
+    case FADD: case FADD32I: case FCHK: case FFMA32I: case FFMA: case FMNMX: case FMUL: case FMUL32I:
+    case FSEL: case FSET: case FSETP: case FSWZADD:
+      return Exec_Unit_Types::FP32;
+    case HADD2: case HADD2_32I: case HFMA2: case HFMA2_32I: case HMUL2: case HMUL2_32I: case HSET2:
+    case HSETP2:
+      return Exec_Unit_Types::FP16;
+    case DADD: case DFMA: case DMUL: case DSETP:
+      return Exec_Unit_Types::FP64;
+    case MUFU:
+      return Exec_Unit_Types::SFU;
+    case HMMA: case BMMA: case IMMA:
+      return Exec_Unit_Types::TENSOR;
+    case IMAD: case IMUL: case IMUL32I: case IDP: case IDP4A: case UIMAD:
+      return Exec_Unit_Types::IMAD;
+    case F2F: case F2I: case I2F: case I2I: case I2IP: case FRND:
+      return Exec_Unit_Types::CONV;
+    case LDS: case LDSM: case STS: case ATOMS:
+      return Exec_Unit_Types::SHARED_MEM;
+    case LD: case LDC: case LDG: case LDL: case ST: case STG: case STL: case ATOM: case ATOMG: case RED:
+    case TEX: case TLD: case TLD4: case TMML: case TXD: case TXQ: case SUATOM: case SULD: case SURED: case SUST:
+      return Exec_Unit_Types::MEM;
+    case BMSK: case BREV: case FLO: case IABS: case IADD: case IADD3: case IADD32I: case IMNMX: case ISCADD:
+    case ISCADD32I: case ISETP: case LEA: case LOP: case LOP3: case LOP32I: case POPC: case SHF: case SHL:
+    case SHR: case VABSDIFF: case VABSDIFF4: case MOV: case MOV32I: case MOVM: case PRMT: case SEL: case SGXT:
+    case SHFL: case PLOP3: case PSETP: case P2R: case R2P: case MATCH: case R2UR: case S2UR: case UBMSK:
+    case UBREV: case UCLEA: case UFLO: case UIADD3: case UIADD3_64: case UISETP: case ULDC: case ULEA:
+    case ULOP: case ULOP3: case ULOP32I: case UMOV: case UP2UR: case UPLOP3: case UPOPC: case UPRMT:
+    case UPSETP: case UR2UP: case USEL: case USGXT: case USHF: case USHL: case USHR: case VOTEU: case VOTE:
+    case CS2R: case S2R:
+      return Exec_Unit_Types::INT;
+    default:
+      return Exec_Unit_Types::MISC;
+  }
+}
+
+// Functional unit pipelines of a core (see core_c::can_issue)
+enum class Func_Unit_Types {
+  SP = 0,       // FP32, FP16 and integer
+  DP,
+  SFU,          // Transcendentals and conversions
+  LDST,
+  TENSOR,
+  NONE,         // Control flow and other instructions that use no unit
+};
+
+constexpr const char* Func_Unit_Types_str[] = {
+  "SP",
+  "DP",
+  "SFU",
+  "LDST",
+  "TENSOR",
+  "NONE"
+};
+
+#define NUM_FUNC_UNIT_TYPES ((int)Func_Unit_Types::NONE)
+
+inline Func_Unit_Types get_func_unit(Exec_Unit_Types exec_unit){
+  switch (exec_unit) {
+    case Exec_Unit_Types::INT: case Exec_Unit_Types::IMAD: case Exec_Unit_Types::FP32: case Exec_Unit_Types::FP16:
+      return Func_Unit_Types::SP;
+    case Exec_Unit_Types::FP64:
+      return Func_Unit_Types::DP;
+    case Exec_Unit_Types::SFU: case Exec_Unit_Types::CONV:
+      return Func_Unit_Types::SFU;
+    case Exec_Unit_Types::SHARED_MEM: case Exec_Unit_Types::MEM:
+      return Func_Unit_Types::LDST;
+    case Exec_Unit_Types::TENSOR:
+      return Func_Unit_Types::TENSOR;
+    default:
+      return Func_Unit_Types::NONE;
+  }
+}
+
 #endif
@@ -0,0 +1,168 @@
+#ifndef WARP_SLOTS_H
+#define WARP_SLOTS_H
+
+#include <vector>
+#include "macsim.h"
+
+enum class Warp_Slot_State {
+  FREE = 0,
+  READY,        // In the ready (dispatched) list
+  RUNNING,      // Picked by the warp scheduler
+  SUSPENDED,    // Waiting for a memory response
+  BARRIER,      // Waiting for the other warps of its block at a barrier (BAR)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// Fixed table of warp slots of a core
+///
+/// Slots are partitioned among the warp schedulers of the core (slot % n_schedulers). Ready
+/// warps of a scheduler form an intrusive doubly linked list through its slots, in dispatch
+/// order, so enqueue, dequeue and removal from the middle (GTO, CCWS) are O(1). Memory
+/// responses carry the slot id of the suspended warp, so waking it up is a direct lookup.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class warp_slots_c {
+public:
+  warp_slots_c(int n_slots=0, int n_schedulers=1) {
+    resize(n_slots, n_schedulers);
+  }
+
+  // Reset to n_slots free slots, shared by n_schedulers schedulers
+  void resize(int n_slots, int n_schedulers=1) {
+    slots.assign(n_slots, slot_s());
+    lists.assign(n_schedulers, list_s());
+    for (int slot = n_slots - 1; slot >= 0; slot--)
+      lists[slot % n_schedulers].free_slots.push_back(slot);
+    n_free = n_slots;
+    n_ready = n_suspended = n_barrier = 0;
+  }
+
+  int size() const { return slots.size(); }
+  int num_schedulers() const { return lists.size(); }
+  int scheduler(int slot) const { return slot % lists.size(); }
+  warp_s* warp(int slot) const { return slots[slot].warp; }
+  Warp_Slot_State state(int slot) const { return slots[slot].state; }
+  bool is_suspended(int slot) const { return slots[slot].state == Warp_Slot_State::SUSPENDED; }
+
+  int num_used() const { return slots.size() - n_free; }
+  int num_ready() const { return n_ready; }
+  int num_suspended() const { return n_suspended; }
+  int num_barrier() const { return n_barrier; }
+  bool ready_empty() const { return n_ready == 0; }
+
+  // Per scheduler
+  int num_used(int sched) const {
+    return (slots.size() - sched + lists.size() - 1) / lists.size() - lists[sched].free_slots.size();
+  }
+  int num_ready(int sched) const { return lists[sched].n_ready; }
+  bool ready_empty(int sched) const { return lists[sched].ready_head == -1; }
+
+  // Ready list iteration of a scheduler (-1 at the end)
+  int first_ready(int sched) const { return lists[sched].ready_head; }
+  int next_ready(int slot) const { return slots[slot].next; }
+
+  // Put a warp in a free slot of the least loaded scheduler, at the tail of its ready list.
+  // Returns the slot id (-1 if full).
+  int add(warp_s* w) {
+    int sched = -1;
+    for (int s = 0; s < (int)lists.size(); s++)
+      if (!lists[s].free_slots.empty() && (sched == -1 || lists[s].free_slots.size() > lists[sched].free_slots.size()))
+        sched = s;
+    if (sched == -1) return -1;
+    int slot = lists[sched].free_slots.back();
+    lists[sched].free_slots.pop_back();
+    n_free--;
+    slots[slot].warp = w;
+    w->slot_id = slot;
+    push_ready(slot);
+    return slot;
+  }
+
+  // Free the slot of a running warp (the warp finished)
+  void remove(int slot) {
+    slots[slot].warp = NULL;
+    slots[slot].state = Warp_Slot_State::FREE;
+    lists[scheduler(slot)].free_slots.push_back(slot);
+    n_free++;
+  }
+
+  // Append a warp to the ready list of its scheduler
+  void push_ready(int slot) {
+    slot_s& s = slots[slot];
+    list_s& l = lists[scheduler(slot)];
+    s.state = Warp_Slot_State::READY;
+    s.prev = l.ready_tail;
+    s.next = -1;
+    if (l.ready_tail != -1) slots[l.ready_tail].next = slot;
+    else l.ready_head = slot;
+    l.ready_tail = slot;
+    l.n_ready++;
+    n_ready++;
+  }
+
+  // Take a warp out of the ready list to run it
+  void pop_ready(int slot) {
+    slot_s& s = slots[slot];
+    list_s& l = lists[scheduler(slot)];
+    if (s.prev != -1) slots[s.prev].next = s.next;
+    else l.ready_head = s.next;
+    if (s.next != -1) slots[s.next].prev = s.prev;
+    else l.ready_tail = s.prev;
+    s.state = Warp_Slot_State::RUNNING;
+    l.n_ready--;
+    n_ready--;
+  }
+
+  // Running warp waits for memory
+  void suspend(int slot) {
+    slots[slot].state = Warp_Slot_State::SUSPENDED;
+    n_suspended++;
+  }
+
+  // Memory response for a suspended warp: back to the ready list
+  void wake(int slot) {
+    n_suspended--;
+    push_ready(slot);
+  }
+
+  // Running warp arrives at a barrier
+  void wait_barrier(int slot) {
+    slots[slot].state = Warp_Slot_State::BARRIER;
+    n_barrier++;
+  }
+
+  // Barrier released: back to the ready list, or suspended if the warp waits for memory
+  void release_barrier(int slot, bool suspend=false) {
+    n_barrier--;
+    if (suspend) {
+      slots[slot].state = Warp_Slot_State::SUSPENDED;
+      n_suspended++;
+    } else {
+      push_ready(slot);
+    }
+  }
+
+private:
+  struct slot_s {
+    warp_s* warp = NULL;
+    Warp_Slot_State state = Warp_Slot_State::FREE;
+    int prev = -1;
+    int next = -1;
+  };
+
+  // Slots owned by one warp scheduler
+  struct list_s {
+    std::vector<int> free_slots;    // Stack, lowest slot id on top
+    int ready_head = -1;
+    int ready_tail = -1;
+    int n_ready = 0;
+  };
+
+  std::vector<slot_s> slots;
+  std::vector<list_s> lists;
+  int n_free;
+  int n_ready;
+  int n_suspended;
+  int n_barrier;
+};
+
+#endif // WARP_SLOTS_H
@@ -11,6 +11,7 @@
 #include "macsim/macsim.h"
 #include "utils/rapidxml/rapidxml.hpp"
 #include "ram.h"
+#include "optimistic.h"
 
 using namespace std;
 
@@ -149,12 +150,26 @@ int main(int argc, char* argv[])
 	queue<RAM_response> *ram_response_queue = new queue<RAM_response>();
 	
 	// Setup sim components
-	RAM ram(200);
+	RAM ram(200);  // latency in DRAM cycles
 	macsim gpu(gpu_params);
 
 	// Attach queues
 	ram.set_queues(ram_request_queue, ram_response_queue);
 	gpu.set_queues(ram_request_queue, ram_response_queue);
+
+	// Memory on its own thread, pipelined against the cores
+	if (gpu_params->RAM_Thread)
+		ram.start_thread(gpu_params->RAM_Thread_Max_Skew);
+
+	// Optimistic parallel simulation (results are identical to serial)
+	optimistic_c* optimistic = NULL;
+	if (gpu_params->Optimistic_Sim_Threads > 1) {
+		if (optimistic_c::is_supported(gpu_params)) {
+			optimistic = new optimistic_c(&gpu, &ram, gpu_params->Optimistic_Sim_Threads, gpu_params->Optimistic_Window);
+		} else {
+			PRINT_MESSAGE("Optimistic simulation is not supported with logging, MSHRs, instruction or constant caches, cache operators, TLBs, L2 atomics or clock domains enabled, running serially")
+		}
+	}
 	
 	// Start simulation
 	time_t start_time = time(0);
@@ -171,7 +186,11 @@ int main(int argc, char* argv[])
 		if (gpu.m_cycle % 100000 == 0) {
 			printf("[Cycle: %lu]: mem_requests: %d, mem_responses: %d, avg_latency: %u\n", gpu.m_cycle, gpu.get_n_requests(), gpu.get_n_responses(), gpu.get_avg_latency());
 		}
-		ram.run_a_cycle();
+		ram.requests_sent(gpu.dram_cycle());
+		ram.run_until(gpu.dram_cycle());
+
+		if (optimistic && !optimistic->run_window(ncycles))
+			break;
 	}
 
 	// End simulation
@@ -182,9 +201,12 @@ int main(int argc, char* argv[])
 	uint64_t duration = (uint64_t)difftime(end_time, start_time);
 	PRINT_MESSAGE("Total simulation time: " << duration / 3600 << ":" << (duration % 3600) / 60 << ":" << ((duration % 3600) % 60))
 	
+	ram.stop_thread();
+	gpu.set_dram_accesses(ram.get_n_reads(), ram.get_n_writes());
 	gpu.print_stats();
 	gpu.end_sim();
 
+	delete optimistic;
 	delete gpu_params;
 	delete ram_request_queue;
 	delete ram_response_queue;